@@ -0,0 +1,172 @@
+#include "AnalysisCache.hpp"
+#include "SimdScanner.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // Hashed into every key, so that entries written by a build that analyzes or renders differently are not used
+    constexpr std::string_view FORMAT = "hw3 analysis cache 2";
+
+    constexpr std::uint64_t PRIME_A = 0x9E3779B97F4A7C15ull;
+    constexpr std::uint64_t PRIME_B = 0xC2B2AE3D27D4EB4Full;
+
+    std::uint64_t rotate(std::uint64_t x, int bits) {
+        return (x << bits) | (x >> (64 - bits));
+    }
+
+    // Final avalanche of a lane, from MurmurHash3
+    std::uint64_t finish(std::uint64_t x) {
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        x *= 0xC4CEB9FE1A85EC53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+    // Distinguishes the temporary files of concurrent writers
+    std::atomic<unsigned> tempCounter(0);
+
+    // Every entry starts with the length and a checksum of the scopes after it, so that a file cut short or
+    // damaged is not taken for a result
+    struct Header {
+        std::uint64_t length;
+        std::uint64_t checksum;
+    };
+
+    std::uint64_t checksum(std::string_view scopes) {
+        AnalysisCache::Hasher hasher;
+        hasher.add(scopes);
+        return hasher.key().low;
+    }
+}
+
+AnalysisCache::Hasher::Hasher() : a(0x243F6A8885A308D3ull), b(0x13198A2E03707344ull) {
+    add(FORMAT);
+}
+
+void AnalysisCache::Hasher::addWord(std::uint64_t word) {
+    a = rotate((a ^ word) * PRIME_A, 31);
+    b = rotate(b + word * PRIME_B, 27) * PRIME_A;
+}
+
+void AnalysisCache::Hasher::add(std::uint64_t value) {
+    addWord(value);
+}
+
+void AnalysisCache::Hasher::add(std::string_view text) {
+    // The length first, so that consecutive strings cannot run into each other
+    addWord(text.size());
+    while (text.size() >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, text.data(), 8);
+        addWord(word);
+        text.remove_prefix(8);
+    }
+    if (!text.empty()) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, text.data(), text.size());
+        addWord(word);
+    }
+}
+
+AnalysisCache::Key AnalysisCache::Hasher::key() const {
+    return {finish(a ^ rotate(b, 17)), finish(b ^ PRIME_B)};
+}
+
+AnalysisCache::AnalysisCache(std::string dir) : dir(std::move(dir)) {
+    ::mkdir(this->dir.c_str(), 0777);
+}
+
+bool AnalysisCache::hashTokens(std::string_view text, Hasher &hasher,
+                               const std::function<void(std::string_view)> &identifier) {
+    SimdScanner scanner(text.data(), text.data() + text.size(), 1);
+    std::string_view token;
+    while (int code = scanner.scan(token)) {
+        if (code == SimdScanner::LEXICAL_ERROR) {
+            return false;
+        }
+        hasher.add(static_cast<std::uint64_t>(code));
+        switch (code) {
+            case ID:
+                hasher.add(token);
+                identifier(token);
+                break;
+            case NUM:
+            case NUM_B:
+            case STRING:
+                hasher.add(token);
+                break;
+        }
+    }
+    return true;
+}
+
+std::string AnalysisCache::path(const Key &key) const {
+    char name[33];
+    std::snprintf(name, sizeof(name), "%016llx%016llx", static_cast<unsigned long long>(key.high),
+                  static_cast<unsigned long long>(key.low));
+    return dir + "/" + name;
+}
+
+bool AnalysisCache::load(const Key &key, std::string &scopes) const {
+    int fd = ::open(path(key).c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    bool ok = ::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) >= sizeof(Header);
+    std::string entry;
+    if (ok) {
+        entry.resize(static_cast<std::size_t>(info.st_size));
+        std::size_t done = 0;
+        while (ok && done < entry.size()) {
+            ssize_t got = ::read(fd, &entry[done], entry.size() - done);
+            if (got < 0 && errno == EINTR) {
+                continue;
+            }
+            ok = got > 0;
+            done += ok ? static_cast<std::size_t>(got) : 0;
+        }
+    }
+    ::close(fd);
+    if (!ok) {
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, entry.data(), sizeof(header));
+    std::string_view body(entry);
+    body.remove_prefix(sizeof(header));
+    if (header.length != body.size() || header.checksum != checksum(body)) {
+        return false;
+    }
+    entry.erase(0, sizeof(header));
+    scopes = std::move(entry);
+    return true;
+}
+
+void AnalysisCache::store(const Key &key, std::string_view scopes) const {
+    std::string target = path(key);
+    std::ostringstream temp;
+    temp << target << ".tmp." << ::getpid() << "." << tempCounter++;
+
+    const Header header{scopes.size(), checksum(scopes)};
+    std::ofstream file(temp.str(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(scopes.data(), static_cast<std::streamsize>(scopes.size()));
+    // Closing flushes, and a write that fails only then must not be renamed into place either
+    file.close();
+    if (file.fail() || std::rename(temp.str().c_str(), target.c_str()) != 0) {
+        std::remove(temp.str().c_str());
+    }
+}
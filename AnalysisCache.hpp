@@ -0,0 +1,63 @@
+#ifndef ANALYSISCACHE_HPP
+#define ANALYSISCACHE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/* On-disk cache of function analyses
+ * A function whose body analyzed cleanly has its rendered scopes stored in a file of the cache directory, named by
+ * a 128-bit hash of everything the analysis read: the function's prototype, the tokens of its body, and what each
+ * parameter and each identifier of the body names in the global scope. Layout, whitespace and comments are not
+ * hashed, so a function keeps its entry when edits elsewhere move it. Failures are not stored: their messages carry
+ * line numbers, and a failing function ends the analysis anyway. Entries are written to a temporary name and renamed
+ * into place, so any number of processes and threads may share a directory, and carry their length and checksum, so
+ * that one cut short is ignored.
+ */
+class AnalysisCache {
+public:
+    struct Key {
+        std::uint64_t high;
+        std::uint64_t low;
+    };
+
+    /* Incremental hash of the inputs of one analysis */
+    class Hasher {
+    public:
+        Hasher();
+
+        void add(std::string_view text);
+
+        void add(std::uint64_t value);
+
+        Key key() const;
+
+    private:
+        std::uint64_t a;
+        std::uint64_t b;
+
+        void addWord(std::uint64_t word);
+    };
+
+    // Uses dir, which is created if it does not exist (its parent must)
+    explicit AnalysisCache(std::string dir);
+
+    // Hashes the tokens of text, a function body, into hasher, and calls identifier with the spelling of each
+    // identifier among them so that the caller can hash what it names. Returns false if text has a lexical error.
+    static bool hashTokens(std::string_view text, Hasher &hasher,
+                           const std::function<void(std::string_view)> &identifier);
+
+    // Reads the scopes stored under key into scopes; returns false if there are none
+    bool load(const Key &key, std::string &scopes) const;
+
+    // Stores scopes under key. The cache only saves work, so a failure to write it is ignored
+    void store(const Key &key, std::string_view scopes) const;
+
+private:
+    std::string dir;
+
+    std::string path(const Key &key) const;
+};
+
+#endif //ANALYSISCACHE_HPP
@@ -0,0 +1,760 @@
+#include "Assembly.hpp"
+#include "Backend.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using bytecode::Instruction;
+using bytecode::Op;
+
+namespace assembly {
+    namespace {
+        /* Machine register a bytecode register can live in */
+        struct Machine {
+            const char *r64;
+            const char *r32;
+        };
+
+        // Kept across calls, so any function may use them, saving those it does in its prologue
+        const Machine CALLEE_SAVED[] = {
+                {"%rbx", "%ebx"}, {"%r12", "%r12d"}, {"%r13", "%r13d"}, {"%r14", "%r14d"}, {"%r15", "%r15d"}
+        };
+        // Free in a function that makes no calls: not scratch (%eax, %ecx, %edx), and kept by the runtime
+        const Machine CALLER_SAVED[] = {
+                {"%r10", "%r10d"}, {"%r11", "%r11d"}, {"%r9", "%r9d"}, {"%r8", "%r8d"}, {"%rsi", "%esi"},
+                {"%rdi", "%edi"}
+        };
+        // Where the System V convention passes the first arguments
+        const char *const ARGUMENTS[] = {"%edi", "%esi", "%edx", "%ecx", "%r8d", "%r9d"};
+        constexpr std::size_t REGISTER_ARGUMENTS = sizeof(ARGUMENTS) / sizeof(*ARGUMENTS);
+        // Loops nested deeper than this weigh no more
+        constexpr std::size_t MAX_DEPTH = 6;
+
+        // Conditional jump taken by each of JEQ..JGE
+        const char *const CONDITIONS[] = {"je", "jne", "jl", "jg", "jle", "jge"};
+
+        // Entry point and the print runtime. Every routine keeps all registers but %rax, so print and printi do not
+        // end a function's use of caller-saved registers. The buffer is 64 KiB
+        const char *const RUNTIME = R"(
+	.globl _start
+_start:
+	call fanc_main
+	call hw3_flush
+	movl $60, %eax
+	xorl %edi, %edi
+	syscall
+
+# Writes the buffered output
+hw3_flush:
+	pushq %rdi
+	pushq %rsi
+	pushq %rdx
+	pushq %rcx
+	pushq %r11
+	leaq hw3_buffer(%rip), %rsi
+	movq hw3_used(%rip), %rdx
+1:	testq %rdx, %rdx
+	jle 2f
+	movl $1, %eax
+	movl $1, %edi
+	syscall
+	testq %rax, %rax
+	jle 2f
+	addq %rax, %rsi
+	subq %rax, %rdx
+	jmp 1b
+2:	movq $0, hw3_used(%rip)
+	popq %r11
+	popq %rcx
+	popq %rdx
+	popq %rsi
+	popq %rdi
+	ret
+
+# Appends the byte in %dl to the output
+hw3_put:
+	pushq %rdi
+	movq hw3_used(%rip), %rax
+	cmpq $65536, %rax
+	jb 1f
+	call hw3_flush
+	xorl %eax, %eax
+1:	leaq hw3_buffer(%rip), %rdi
+	movb %dl, (%rdi,%rax)
+	incq %rax
+	movq %rax, hw3_used(%rip)
+	popq %rdi
+	ret
+
+# Prints the string %rax points to, a 32-bit length followed by its bytes, and a newline
+hw3_print:
+	pushq %rcx
+	pushq %rdx
+	pushq %rsi
+	movl (%rax), %ecx
+	leaq 4(%rax), %rsi
+1:	testl %ecx, %ecx
+	jz 2f
+	movb (%rsi), %dl
+	call hw3_put
+	incq %rsi
+	decl %ecx
+	jmp 1b
+2:	movb $10, %dl
+	call hw3_put
+	popq %rsi
+	popq %rdx
+	popq %rcx
+	ret
+
+# Prints %eax in decimal and a newline
+hw3_printi:
+	pushq %rcx
+	pushq %rdx
+	pushq %rsi
+	pushq %rdi
+	subq $24, %rsp
+	movslq %eax, %rax
+	movq %rax, %rdi
+	testq %rax, %rax
+	jns 1f
+	negq %rax
+1:	leaq 24(%rsp), %rsi
+	movl $10, %ecx
+2:	xorl %edx, %edx
+	divq %rcx
+	addb $48, %dl
+	decq %rsi
+	movb %dl, (%rsi)
+	testq %rax, %rax
+	jnz 2b
+	testq %rdi, %rdi
+	jns 3f
+	decq %rsi
+	movb $45, (%rsi)
+3:	leaq 24(%rsp), %rcx
+4:	movb (%rsi), %dl
+	call hw3_put
+	incq %rsi
+	cmpq %rcx, %rsi
+	jb 4b
+	movb $10, %dl
+	call hw3_put
+	addq $24, %rsp
+	popq %rdi
+	popq %rsi
+	popq %rdx
+	popq %rcx
+	ret
+
+# Ends the program as the FanC runtime does on a division by zero
+hw3_divzero:
+	leaq hw3_divzero_message(%rip), %rax
+	call hw3_print
+	call hw3_flush
+	movl $60, %eax
+	xorl %edi, %edi
+	syscall
+
+	.section .rodata
+hw3_divzero_message:
+	.long 22
+	.ascii "Error division by zero"
+
+	.bss
+	.align 8
+hw3_used:
+	.zero 8
+hw3_buffer:
+	.zero 65536
+)";
+
+        // Calls f with every register ins reads; a call reads its arguments from the registers its frame starts at
+        template<typename F>
+        void forReads(const bytecode::Program &program, const Instruction &ins, F f) {
+            switch (ins.op) {
+                case Op::ADD:
+                case Op::SUB:
+                case Op::MUL:
+                case Op::DIV:
+                case Op::JEQ:
+                case Op::JNE:
+                case Op::JLT:
+                case Op::JGT:
+                case Op::JLE:
+                case Op::JGE:
+                    f(ins.b);
+                    f(ins.c);
+                    break;
+                case Op::MOVE:
+                case Op::ADDI:
+                case Op::TRUNC:
+                case Op::JT:
+                case Op::JF:
+                    f(ins.b);
+                    break;
+                case Op::RET:
+                case Op::PRINTI:
+                    f(ins.a);
+                    break;
+                case Op::CALL:
+                    for (std::uint32_t i = 0; i < program.functions[ins.b].params; ++i) {
+                        f(ins.c + static_cast<std::int32_t>(i));
+                    }
+                    break;
+                case Op::LOADI:
+                case Op::JMP:
+                case Op::RETV:
+                case Op::PRINT:
+                    break;
+            }
+        }
+
+        // Register ins writes, or -1
+        std::int32_t written(const Instruction &ins) {
+            switch (ins.op) {
+                case Op::LOADI:
+                case Op::MOVE:
+                case Op::ADD:
+                case Op::SUB:
+                case Op::MUL:
+                case Op::DIV:
+                case Op::ADDI:
+                case Op::TRUNC:
+                case Op::CALL:
+                    return ins.a;
+                default:
+                    return -1;
+            }
+        }
+
+        bool isJump(Op op) {
+            return op >= Op::JMP && op <= Op::JGE;
+        }
+
+        /* Which registers of a function hold values needed at the same time
+         * Found by the usual backward dataflow over the function's code: a register written by an instruction
+         * conflicts with every other register live after it, and the parameters, all written on entry, with each
+         * other and with whatever is live there. Functions with more registers than MAX_TRACKED are not analyzed,
+         * and all of their registers conflict.
+         */
+        class Interference {
+        public:
+            static constexpr std::size_t MAX_TRACKED = 2048;
+
+            Interference(const bytecode::Program &program, std::size_t begin, std::size_t end,
+                         const bytecode::Function &function)
+                    : registers(function.registers), words((function.registers + 63) / 64),
+                      tracked(function.registers <= MAX_TRACKED) {
+                if (!tracked || registers == 0) {
+                    return;
+                }
+                std::size_t length = end - begin;
+                std::vector<std::uint64_t> liveIn(length * words, 0);
+                std::vector<std::uint64_t> out(words);
+                // Live after pc, from what is live into its successors
+                auto liveOut = [&](std::size_t pc) {
+                    std::fill(out.begin(), out.end(), 0);
+                    const Instruction &ins = program.code[pc];
+                    auto merge = [&](std::size_t next) {
+                        for (std::size_t w = 0; w < words; ++w) {
+                            out[w] |= liveIn[(next - begin) * words + w];
+                        }
+                    };
+                    if (isJump(ins.op)) {
+                        merge(static_cast<std::size_t>(ins.a));
+                    }
+                    if (ins.op != Op::JMP && ins.op != Op::RET && ins.op != Op::RETV && pc + 1 < end) {
+                        merge(pc + 1);
+                    }
+                };
+                for (bool changed = true; changed;) {
+                    changed = false;
+                    for (std::size_t pc = end; pc-- > begin;) {
+                        liveOut(pc);
+                        const Instruction &ins = program.code[pc];
+                        std::int32_t reg = written(ins);
+                        if (reg >= 0) {
+                            clear(out.data(), static_cast<std::size_t>(reg));
+                        }
+                        forReads(program, ins, [&](std::int32_t read) {
+                            set(out.data(), static_cast<std::size_t>(read));
+                        });
+                        std::uint64_t *in = liveIn.data() + (pc - begin) * words;
+                        if (!std::equal(out.begin(), out.end(), in)) {
+                            std::copy(out.begin(), out.end(), in);
+                            changed = true;
+                        }
+                    }
+                }
+
+                edges.assign(registers * words, 0);
+                for (std::size_t pc = begin; pc < end; ++pc) {
+                    std::int32_t reg = written(program.code[pc]);
+                    if (reg >= 0) {
+                        liveOut(pc);
+                        connect(static_cast<std::size_t>(reg), out);
+                    }
+                }
+                std::vector<std::uint64_t> entry(liveIn.begin(), liveIn.begin() + static_cast<long>(words));
+                for (std::size_t param = 0; param < function.params; ++param) {
+                    set(entry.data(), param);
+                }
+                for (std::size_t param = 0; param < function.params; ++param) {
+                    connect(param, entry);
+                }
+            }
+
+            bool conflict(std::size_t x, std::size_t y) const {
+                return !tracked || (edges[x * words + y / 64] >> (y % 64) & 1) != 0;
+            }
+
+        private:
+            std::size_t registers;
+            std::size_t words;
+            bool tracked;
+            // Bit y of row x is set when x and y conflict
+            std::vector<std::uint64_t> edges;
+
+            static void set(std::uint64_t *bits, std::size_t i) {
+                bits[i / 64] |= std::uint64_t(1) << (i % 64);
+            }
+
+            static void clear(std::uint64_t *bits, std::size_t i) {
+                bits[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+            }
+
+            // Makes reg conflict with every other register in live
+            void connect(std::size_t reg, const std::vector<std::uint64_t> &live) {
+                for (std::size_t other = 0; other < registers; ++other) {
+                    if (other != reg && (live[other / 64] >> (other % 64) & 1) != 0) {
+                        set(&edges[reg * words], other);
+                        set(&edges[other * words], reg);
+                    }
+                }
+            }
+        };
+
+        /* Writes one function */
+        class FunctionWriter {
+        public:
+            FunctionWriter(const bytecode::Program &program, std::size_t index, std::string &text, AsmOutput output)
+                    : program(program), function(program.functions[index]), index(index),
+                      begin(function.entry),
+                      end(index + 1 < program.functions.size() ? program.functions[index + 1].entry
+                                                                 : program.code.size()),
+                      text(text) {
+                place(output);
+            }
+
+            void write() {
+                put("\n# ", function.name, " (", function.params, " params, ", function.registers, " registers)\n");
+                label("fanc_", function.name);
+                prologue();
+                for (std::size_t pc = begin; pc < end; ++pc) {
+                    if (targets[pc - begin]) {
+                        label(".L", pc);
+                    }
+                    instruction(pc, program.code[pc]);
+                }
+                epilogue();
+            }
+
+        private:
+            const bytecode::Program &program;
+            const bytecode::Function &function;
+            std::size_t index;
+            std::size_t begin;
+            std::size_t end;
+            // Where the function is written
+            std::string &text;
+            // Operand for each register of the bytecode, and the machine register it lives in if any
+            std::vector<std::string> where;
+            std::vector<const Machine *> machines;
+            std::vector<bool> inMachine;
+            // Callee-saved registers used, in the order they are pushed
+            std::vector<const Machine *> saved;
+            // Whether a parameter passed in a register lives in a caller-saved one, which may also be passing
+            // another argument when the function starts
+            bool staged = false;
+            std::vector<bool> targets;
+            std::uint32_t frameBytes = 0;
+
+            std::string slot(std::size_t reg) const {
+                return std::to_string(-static_cast<long>(8 * saved.size() + 4 * (reg + 1))) + "(%rbp)";
+            }
+
+            // Gives the most used registers machine registers and the others a slot in the frame. A use inside
+            // loops weighs 8 times more for every loop around it, a loop being the code a backward jump goes over.
+            // Registers whose values are never needed at once share a machine register
+            void place(AsmOutput output) {
+                std::size_t length = end - begin;
+                targets.assign(length, false);
+                std::vector<long> depth(length + 1, 0);
+                bool leaf = true;
+                for (std::size_t pc = begin; pc < end; ++pc) {
+                    const Instruction &ins = program.code[pc];
+                    if (isJump(ins.op)) {
+                        std::size_t to = static_cast<std::size_t>(ins.a);
+                        targets[to - begin] = true;
+                        if (to <= pc) {
+                            ++depth[to - begin];
+                            --depth[pc - begin + 1];
+                        }
+                    }
+                    leaf = leaf && ins.op != Op::CALL;
+                }
+                std::partial_sum(depth.begin(), depth.end(), depth.begin());
+
+                std::vector<std::uint64_t> weight(function.registers, 0);
+                for (std::size_t pc = begin; pc < end; ++pc) {
+                    std::size_t nesting = std::min<std::size_t>(static_cast<std::size_t>(depth[pc - begin]), MAX_DEPTH);
+                    std::uint64_t use = std::uint64_t(1) << (3 * nesting);
+                    forReads(program, program.code[pc], [&](std::int32_t reg) {
+                        weight[static_cast<std::size_t>(reg)] += use;
+                    });
+                    if (written(program.code[pc]) >= 0) {
+                        weight[static_cast<std::size_t>(written(program.code[pc]))] += use;
+                    }
+                }
+
+                std::vector<const Machine *> pool;
+                if (output == AsmOutput::Registers) {
+                    if (leaf) {
+                        for (const Machine &m: CALLER_SAVED) {
+                            pool.push_back(&m);
+                        }
+                    }
+                    for (const Machine &m: CALLEE_SAVED) {
+                        pool.push_back(&m);
+                    }
+                }
+                machines.assign(function.registers, nullptr);
+                if (!pool.empty()) {
+                    share(pool, weight);
+                }
+                for (const Machine &m: CALLEE_SAVED) {
+                    if (std::find(machines.begin(), machines.end(), &m) != machines.end()) {
+                        saved.push_back(&m);
+                    }
+                }
+
+                // Every register has a slot, so that parameters can be staged through theirs
+                frameBytes = 4 * function.registers;
+                frameBytes += (16 - (8 * saved.size() + frameBytes) % 16) % 16;
+                where.resize(function.registers);
+                inMachine.resize(function.registers);
+                for (std::size_t reg = 0; reg < function.registers; ++reg) {
+                    inMachine[reg] = machines[reg] != nullptr;
+                    if (inMachine[reg]) {
+                        where[reg] = machines[reg]->r32;
+                        staged = staged || (reg < std::min<std::size_t>(function.params, REGISTER_ARGUMENTS) &&
+                                            std::find(saved.begin(), saved.end(), machines[reg]) == saved.end());
+                    } else if (reg >= REGISTER_ARGUMENTS && reg < function.params) {
+                        // Left where the caller pushed it
+                        where[reg] = incoming(reg);
+                    } else {
+                        where[reg] = slot(reg);
+                    }
+                }
+            }
+
+            // Hands out pool to registers, most weighed first, each to the first machine register that holds no
+            // register it conflicts with
+            void share(const std::vector<const Machine *> &pool, const std::vector<std::uint64_t> &weight) {
+                std::vector<std::size_t> order(function.registers);
+                std::iota(order.begin(), order.end(), 0);
+                std::stable_sort(order.begin(), order.end(),
+                                 [&](std::size_t x, std::size_t y) { return weight[x] > weight[y]; });
+                Interference interference(program, begin, end, function);
+                // Registers each machine register holds
+                std::vector<std::vector<std::size_t>> held(pool.size());
+                for (std::size_t reg: order) {
+                    if (weight[reg] == 0) {
+                        break;
+                    }
+                    for (std::size_t m = 0; m < pool.size(); ++m) {
+                        bool free = std::none_of(held[m].begin(), held[m].end(), [&](std::size_t other) {
+                            return interference.conflict(reg, other);
+                        });
+                        if (free) {
+                            held[m].push_back(reg);
+                            machines[reg] = pool[m];
+                            break;
+                        }
+                    }
+                }
+            }
+
+            static std::string incoming(std::size_t param) {
+                return std::to_string(16 + 8 * (param - REGISTER_ARGUMENTS)) + "(%rbp)";
+            }
+
+            // Writes text made of strings and numbers
+            template<typename... Pieces>
+            void put(const Pieces &... pieces) {
+                (backend::Writer::append(text, pieces), ...);
+            }
+
+            // Writes one instruction from its pieces
+            template<typename... Pieces>
+            void line(const Pieces &... pieces) {
+                put('\t', pieces..., '\n');
+            }
+
+            template<typename... Pieces>
+            void label(const Pieces &... pieces) {
+                put(pieces..., ":\n");
+            }
+
+            void prologue() {
+                line("pushq %rbp");
+                line("movq %rsp, %rbp");
+                for (const Machine *m: saved) {
+                    line("pushq ", m->r64);
+                }
+                if (frameBytes != 0) {
+                    line("subq $", frameBytes, ", %rsp");
+                }
+                std::size_t passed = std::min<std::size_t>(function.params, REGISTER_ARGUMENTS);
+                for (std::size_t i = 0; i < passed; ++i) {
+                    line("movl ", ARGUMENTS[i], ", ", (staged ? slot(i) : where[i]));
+                }
+                for (std::size_t i = 0; i < function.params; ++i) {
+                    if (i >= REGISTER_ARGUMENTS && inMachine[i]) {
+                        line("movl ", incoming(i), ", ", where[i]);
+                    } else if (i < REGISTER_ARGUMENTS && staged && inMachine[i]) {
+                        line("movl ", slot(i), ", ", where[i]);
+                    }
+                }
+            }
+
+            void epilogue() {
+                label(".Lret", index);
+                if (saved.empty()) {
+                    line("leave");
+                } else {
+                    line("leaq ", -static_cast<long>(8 * saved.size()), "(%rbp), %rsp");
+                    for (auto m = saved.rbegin(); m != saved.rend(); ++m) {
+                        line("popq ", (*m)->r64);
+                    }
+                    line("popq %rbp");
+                }
+                line("ret");
+            }
+
+            // Whether registers x and y are kept in the same place, as registers sharing a machine register are
+            bool same(std::int32_t x, std::int32_t y) const {
+                return where[x] == where[y];
+            }
+
+            // r[to] = r[from]; memory to memory goes through %eax
+            void move(std::int32_t from, std::int32_t to) {
+                if (same(from, to)) {
+                    return;
+                }
+                if (!inMachine[from] && !inMachine[to]) {
+                    line("movl ", where[from], ", %eax");
+                    line("movl %eax, ", where[to]);
+                } else {
+                    line("movl ", where[from], ", ", where[to]);
+                }
+            }
+
+            // r[a] = r[b] op r[c], computed in place when r[a] is a machine register
+            void arithmetic(const char *op, bool commutative, std::int32_t a, std::int32_t b, std::int32_t c) {
+                if (inMachine[a] && (!same(a, c) || same(a, b))) {
+                    move(b, a);
+                    line(op, ' ', where[c], ", ", where[a]);
+                } else if (inMachine[a] && commutative) {
+                    line(op, ' ', where[b], ", ", where[a]);
+                } else {
+                    line("movl ", where[b], ", %eax");
+                    line(op, ' ', where[c], ", %eax");
+                    line("movl %eax, ", where[a]);
+                }
+            }
+
+            void jump(const char *condition, std::int32_t target) {
+                line(condition, " .L", target);
+            }
+
+            void instruction(std::size_t pc, const Instruction &ins) {
+                switch (ins.op) {
+                    case Op::LOADI:
+                        line("movl $", ins.b, ", ", where[ins.a]);
+                        break;
+                    case Op::MOVE:
+                        move(ins.b, ins.a);
+                        break;
+                    case Op::ADD:
+                        arithmetic("addl", true, ins.a, ins.b, ins.c);
+                        break;
+                    case Op::SUB:
+                        arithmetic("subl", false, ins.a, ins.b, ins.c);
+                        break;
+                    case Op::MUL:
+                        arithmetic("imull", true, ins.a, ins.b, ins.c);
+                        break;
+                    case Op::DIV:
+                        // idiv traps on INT_MIN / -1, which wraps like the other operations instead
+                        line("movl ", where[ins.c], ", %ecx");
+                        line("testl %ecx, %ecx");
+                        line("je hw3_divzero");
+                        line("movl ", where[ins.b], ", %eax");
+                        line("cmpl $-1, %ecx");
+                        line("jne 1f");
+                        line("negl %eax");
+                        line("jmp 2f");
+                        text += "1:";
+                        line("cltd");
+                        line("idivl %ecx");
+                        text += "2:";
+                        line("movl %eax, ", where[ins.a]);
+                        break;
+                    case Op::ADDI:
+                        if (same(ins.a, ins.b)) {
+                            line("addl $", ins.c, ", ", where[ins.a]);
+                        } else if (inMachine[ins.a] && inMachine[ins.b]) {
+                            line("leal ", ins.c, "(", machines[ins.b]->r64, "), ", where[ins.a]);
+                        } else if (inMachine[ins.a]) {
+                            move(ins.b, ins.a);
+                            line("addl $", ins.c, ", ", where[ins.a]);
+                        } else {
+                            line("movl ", where[ins.b], ", %eax");
+                            line("addl $", ins.c, ", %eax");
+                            line("movl %eax, ", where[ins.a]);
+                        }
+                        break;
+                    case Op::TRUNC:
+                        if (same(ins.a, ins.b) || inMachine[ins.a]) {
+                            move(ins.b, ins.a);
+                            line("andl $255, ", where[ins.a]);
+                        } else {
+                            line("movl ", where[ins.b], ", %eax");
+                            line("movzbl %al, %eax");
+                            line("movl %eax, ", where[ins.a]);
+                        }
+                        break;
+                    case Op::JMP:
+                        if (static_cast<std::size_t>(ins.a) != pc + 1) {
+                            jump("jmp", ins.a);
+                        }
+                        break;
+                    case Op::JT:
+                    case Op::JF:
+                        if (inMachine[ins.b]) {
+                            line("testl ", where[ins.b], ", ", where[ins.b]);
+                        } else {
+                            line("cmpl $0, ", where[ins.b]);
+                        }
+                        jump(ins.op == Op::JT ? "jne" : "je", ins.a);
+                        break;
+                    case Op::JEQ:
+                    case Op::JNE:
+                    case Op::JLT:
+                    case Op::JGT:
+                    case Op::JLE:
+                    case Op::JGE:
+                        if (!inMachine[ins.b] && !inMachine[ins.c]) {
+                            line("movl ", where[ins.b], ", %eax");
+                            line("cmpl ", where[ins.c], ", %eax");
+                        } else {
+                            line("cmpl ", where[ins.c], ", ", where[ins.b]);
+                        }
+                        jump(CONDITIONS[static_cast<std::size_t>(ins.op) - static_cast<std::size_t>(Op::JEQ)],
+                             ins.a);
+                        break;
+                    case Op::CALL:
+                        call(ins);
+                        break;
+                    case Op::RET:
+                        line("movl ", where[ins.a], ", %eax");
+                        // fall through
+                    case Op::RETV:
+                        if (pc + 1 != end) {
+                            line("jmp .Lret", index);
+                        }
+                        break;
+                    case Op::PRINT:
+                        line("leaq .Ls", ins.a, "(%rip), %rax");
+                        line("call hw3_print");
+                        break;
+                    case Op::PRINTI:
+                        line("movl ", where[ins.a], ", %eax");
+                        line("call hw3_printi");
+                        break;
+                }
+            }
+
+            // A function that calls keeps only callee-saved registers, so loading the arguments clobbers nothing
+            void call(const Instruction &ins) {
+                const bytecode::Function &callee = program.functions[ins.b];
+                std::size_t pushed = callee.params > REGISTER_ARGUMENTS ? callee.params - REGISTER_ARGUMENTS : 0;
+                // The stack stays 16-byte aligned at the call
+                std::size_t padding = pushed % 2 == 0 ? 0 : 8;
+                if (padding != 0) {
+                    line("subq $8, %rsp");
+                }
+                for (std::size_t i = callee.params; i-- > REGISTER_ARGUMENTS;) {
+                    std::int32_t reg = ins.c + static_cast<std::int32_t>(i);
+                    if (inMachine[reg]) {
+                        line("pushq ", machines[reg]->r64);
+                    } else {
+                        line("movl ", where[reg], ", %eax");
+                        line("pushq %rax");
+                    }
+                }
+                for (std::size_t i = 0; i < callee.params && i < REGISTER_ARGUMENTS; ++i) {
+                    line("movl ", where[ins.c + static_cast<std::int32_t>(i)], ", ", ARGUMENTS[i]);
+                }
+                line("call fanc_", callee.name);
+                if (pushed != 0) {
+                    line("addq $", 8 * pushed + padding, ", %rsp");
+                }
+                line("movl %eax, ", where[ins.a]);
+            }
+
+        };
+
+        // A string constant as the runtime prints it: its length, then its bytes
+        void writeString(std::ostream &os, std::size_t index, const std::string &text) {
+            os << ".Ls" << index << ":\n\t.long " << text.size() << "\n\t.ascii \"";
+            for (char c: text) {
+                auto byte = static_cast<unsigned char>(c);
+                if (c == '"' || c == '\\') {
+                    os << '\\' << c;
+                } else if (byte < 0x20 || byte >= 0x7f) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\%03o", byte);
+                    os << escaped;
+                } else {
+                    os << c;
+                }
+            }
+            os << "\"\n";
+        }
+    }
+
+    void emit(const bytecode::Program &program, std::ostream &os, AsmOutput output) {
+        os << "# FanC program, written by hw3 --emit-asm" << (output == AsmOutput::Stack ? "=stack" : "") << "\n"
+           << "\t.text\n";
+        backend::Writer writer(os);
+        for (std::size_t f = 0; f < program.functions.size(); ++f) {
+            FunctionWriter(program, f, writer.text, output).write();
+            writer.spill();
+        }
+        writer.flush();
+        os << RUNTIME;
+        if (!program.strings.empty()) {
+            os << "\n\t.section .rodata\n";
+            for (std::size_t s = 0; s < program.strings.size(); ++s) {
+                writeString(os, s, program.strings[s]);
+            }
+        }
+    }
+}
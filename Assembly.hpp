@@ -0,0 +1,32 @@
+#ifndef ASSEMBLY_HPP
+#define ASSEMBLY_HPP
+
+#include <ostream>
+
+#include "Bytecode.hpp"
+
+/* How --emit-asm places the registers of the bytecode */
+enum class AsmOutput {
+    None,
+    // The most used registers of each function, weighted by loop nesting, live in machine registers: the
+    // callee-saved ones, and in functions that make no calls the free caller-saved ones too. Registers whose values
+    // are never needed at once share one. The rest live in the function's frame
+    Registers,
+    // Every register lives in the frame and every instruction goes through %eax, the unoptimized baseline
+    Stack
+};
+
+/* x86-64 assembly for FanC programs, written by --emit-asm
+ * The bytecode of a checked program (see Bytecode) is translated instruction by instruction to GNU as source in
+ * AT&T syntax. Functions follow the System V calling convention: the first six arguments in %edi, %esi, %edx, %ecx,
+ * %r8d and %r9d, the others on the stack, the result in %eax. The output is a whole program with a runtime of its own
+ * that needs no C library: _start calls main, and print and printi append to a buffer that is written with the
+ * write system call when it fills and before the program exits. Build and run it with
+ *     hw3 --emit-asm < prog.in > prog.s && as prog.s -o prog.o && ld prog.o -o prog && ./prog
+ */
+namespace assembly {
+    // Writes program as assembly to os, with registers placed as output says (not None)
+    void emit(const bytecode::Program &program, std::ostream &os, AsmOutput output);
+}
+
+#endif //ASSEMBLY_HPP
@@ -0,0 +1,343 @@
+#include "AstImage.hpp"
+#include "Trace.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+    constexpr char MAGIC[6] = {'H', 'W', '3', 'A', 'S', 'T'};
+    constexpr std::uint16_t VERSION = 1;
+    constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    // Offset of a missing child while writing
+    constexpr std::size_t NONE = SIZE_MAX;
+
+    struct Header {
+        char magic[6];
+        std::uint16_t version;
+        std::uint32_t byteOrder;
+        std::uint32_t nameCount;
+        std::uint32_t nameBytes;
+        std::uint8_t nodeSizes[28];
+        std::uint64_t treeBytes;
+        std::uint64_t root;
+    };
+
+    static_assert(sizeof(Header) == 64, "the header is 64 bytes");
+
+    // Size of every node class, by NodeKind, as this build lays them out
+    void nodeSizes(std::uint8_t (&sizes)[28]) {
+        using namespace ast;
+        std::memset(sizes, 0, sizeof(sizes));
+        std::size_t all[] = {
+                sizeof(Num), sizeof(NumB), sizeof(String), sizeof(Bool), sizeof(ID), sizeof(BinOp), sizeof(RelOp),
+                sizeof(Not), sizeof(And), sizeof(Or), sizeof(Type), sizeof(Cast), sizeof(ExpList), sizeof(Call),
+                sizeof(Statements), sizeof(Break), sizeof(Continue), sizeof(Return), sizeof(If), sizeof(While),
+                sizeof(VarDecl), sizeof(Assign), sizeof(Formal), sizeof(Formals), sizeof(FuncDecl), sizeof(Funcs)
+        };
+        static_assert(sizeof(all) / sizeof(all[0]) <= sizeof(sizes), "a size for every node class");
+        for (std::size_t i = 0; i < sizeof(all) / sizeof(all[0]); ++i) {
+            sizes[i] = static_cast<std::uint8_t>(all[i]);
+        }
+    }
+
+    /* Copies a tree into one growing block, children before their parents
+     * The block may move as it grows, which leaves the Refs inside it valid; positions in it are kept as offsets,
+     * and turned into addresses only between one allocation and the next.
+     */
+    class TreeCopier {
+    public:
+        TreeCopier() = default;
+
+        TreeCopier(const TreeCopier &) = delete;
+
+        TreeCopier &operator=(const TreeCopier &) = delete;
+
+        ~TreeCopier() { std::free(block); }
+
+        const char *data() const { return block; }
+
+        std::size_t size() const { return used; }
+
+        // Copies node and everything below it, and returns the offset of the copy
+        std::size_t copy(const ast::Node *node) {
+            using namespace ast;
+            if (node == nullptr) {
+                return NONE;
+            }
+            switch (node->kind) {
+                case NodeKind::Num:
+                    return make<Num>(*node, static_cast<const Num *>(node)->value);
+                case NodeKind::NumB:
+                    return make<NumB>(*node, static_cast<const NumB *>(node)->value);
+                case NodeKind::String: {
+                    std::string_view value = static_cast<const String *>(node)->value();
+                    std::size_t chars = allocate(value.size(), 1);
+                    std::memcpy(block + chars, value.data(), value.size());
+                    std::size_t self = allocate(sizeof(String), alignof(String));
+                    return stamp(new(block + self) String(std::string_view(block + chars, value.size())), *node);
+                }
+                case NodeKind::Bool:
+                    return make<Bool>(*node, static_cast<const Bool *>(node)->value);
+                case NodeKind::ID:
+                    return make<ID>(*node, static_cast<const ID *>(node)->value);
+                case NodeKind::BinOp: {
+                    auto &op = static_cast<const BinOp &>(*node);
+                    std::size_t left = copy(op.left), right = copy(op.right);
+                    return make<BinOp>(*node, At<Exp>{left}, At<Exp>{right}, op.op);
+                }
+                case NodeKind::RelOp: {
+                    auto &op = static_cast<const RelOp &>(*node);
+                    std::size_t left = copy(op.left), right = copy(op.right);
+                    return make<RelOp>(*node, At<Exp>{left}, At<Exp>{right}, op.op);
+                }
+                case NodeKind::Not:
+                    return make<Not>(*node, At<Exp>{copy(static_cast<const Not *>(node)->exp)});
+                case NodeKind::And: {
+                    auto &op = static_cast<const And &>(*node);
+                    std::size_t left = copy(op.left), right = copy(op.right);
+                    return make<And>(*node, At<Exp>{left}, At<Exp>{right});
+                }
+                case NodeKind::Or: {
+                    auto &op = static_cast<const Or &>(*node);
+                    std::size_t left = copy(op.left), right = copy(op.right);
+                    return make<Or>(*node, At<Exp>{left}, At<Exp>{right});
+                }
+                case NodeKind::Type:
+                    return make<Type>(*node, static_cast<const Type *>(node)->type);
+                case NodeKind::Cast: {
+                    auto &cast = static_cast<const Cast &>(*node);
+                    std::size_t exp = copy(cast.exp), type = copy(cast.target_type);
+                    return make<Cast>(*node, At<Exp>{exp}, At<Type>{type});
+                }
+                case NodeKind::ExpList:
+                    return list<ExpList, Exp>(*node, static_cast<const ExpList *>(node)->exps, &ExpList::exps);
+                case NodeKind::Call: {
+                    auto &call = static_cast<const Call &>(*node);
+                    std::size_t id = copy(call.func_id), args = copy(call.args);
+                    return make<Call>(*node, At<ID>{id}, At<ExpList>{args});
+                }
+                case NodeKind::Statements:
+                    return list<Statements, Statement>(*node, static_cast<const Statements *>(node)->statements,
+                                                       &Statements::statements);
+                case NodeKind::Break:
+                    return make<Break>(*node);
+                case NodeKind::Continue:
+                    return make<Continue>(*node);
+                case NodeKind::Return:
+                    return make<Return>(*node, At<Exp>{copy(static_cast<const Return *>(node)->exp)});
+                case NodeKind::If: {
+                    auto &branch = static_cast<const If &>(*node);
+                    std::size_t condition = copy(branch.condition), then = copy(branch.then);
+                    std::size_t otherwise = copy(branch.otherwise);
+                    return make<If>(*node, At<Exp>{condition}, At<Statement>{then}, At<Statement>{otherwise});
+                }
+                case NodeKind::While: {
+                    auto &loop = static_cast<const While &>(*node);
+                    std::size_t condition = copy(loop.condition), body = copy(loop.body);
+                    return make<While>(*node, At<Exp>{condition}, At<Statement>{body});
+                }
+                case NodeKind::VarDecl: {
+                    auto &decl = static_cast<const VarDecl &>(*node);
+                    std::size_t id = copy(decl.id), type = copy(decl.type), init = copy(decl.init_exp);
+                    return make<VarDecl>(*node, At<ID>{id}, At<Type>{type}, At<Exp>{init});
+                }
+                case NodeKind::Assign: {
+                    auto &assign = static_cast<const Assign &>(*node);
+                    std::size_t id = copy(assign.id), exp = copy(assign.exp);
+                    return make<Assign>(*node, At<ID>{id}, At<Exp>{exp});
+                }
+                case NodeKind::Formal: {
+                    auto &formal = static_cast<const Formal &>(*node);
+                    std::size_t id = copy(formal.id), type = copy(formal.type);
+                    return make<Formal>(*node, At<ID>{id}, At<Type>{type});
+                }
+                case NodeKind::Formals:
+                    return list<Formals, Formal>(*node, static_cast<const Formals *>(node)->formals,
+                                                 &Formals::formals);
+                case NodeKind::FuncDecl: {
+                    auto &decl = static_cast<const FuncDecl &>(*node);
+                    std::size_t id = copy(decl.id), type = copy(decl.return_type);
+                    std::size_t formals = copy(decl.formals), body = copy(decl.body);
+                    return make<FuncDecl>(*node, At<ID>{id}, At<Type>{type}, At<Formals>{formals},
+                                          At<Statements>{body});
+                }
+                case NodeKind::Funcs:
+                    return list<Funcs, FuncDecl>(*node, static_cast<const Funcs *>(node)->funcs, &Funcs::funcs);
+            }
+            throw std::logic_error("corrupted kind tag");
+        }
+
+    private:
+        char *block = nullptr;
+        std::size_t used = 0;
+        std::size_t capacity = 0;
+
+        // Reserves size bytes aligned to align and returns their offset; addresses in the block change
+        std::size_t allocate(std::size_t size, std::size_t align) {
+            std::size_t offset = (used + align - 1) / align * align;
+            if (offset + size > capacity) {
+                std::size_t grown = capacity == 0 ? 64 * 1024 : capacity;
+                while (grown < offset + size) {
+                    grown *= 2;
+                }
+                char *moved = static_cast<char *>(std::realloc(block, grown));
+                if (moved == nullptr) {
+                    throw std::bad_alloc();
+                }
+                block = moved;
+                capacity = grown;
+            }
+            std::memset(block + used, 0, offset + size - used);
+            used = offset + size;
+            return offset;
+        }
+
+        template<typename T>
+        T *at(std::size_t offset) const {
+            return offset == NONE ? nullptr : reinterpret_cast<T *>(block + offset);
+        }
+
+        /* Offset of a copied child, as a constructor argument of its parent */
+        template<typename T>
+        struct At {
+            std::size_t offset;
+        };
+
+        template<typename T>
+        T *resolve(At<T> child) const { return at<T>(child.offset); }
+
+        template<typename V>
+        V resolve(V value) const { return value; }
+
+        std::size_t stamp(ast::Node *copy, const ast::Node &node) const {
+            copy->line = node.line;
+            return reinterpret_cast<char *>(copy) - block;
+        }
+
+        // Constructs a copy of node from args, in which children are given as offsets, since the allocation may
+        // move the block
+        template<typename T, typename... Args>
+        std::size_t make(const ast::Node &node, Args... args) {
+            std::size_t self = allocate(sizeof(T), alignof(T));
+            return stamp(new(block + self) T(resolve(args)...), node);
+        }
+
+        // Copies a list node, whose items go in an array of their own just before it
+        template<typename T, typename Item>
+        std::size_t list(const ast::Node &node, const ast::List<Item> &items, ast::List<Item> T::*field) {
+            std::vector<std::size_t> copies;
+            copies.reserve(items.size());
+            for (Item *item: items) {
+                copies.push_back(copy(item));
+            }
+            auto count = static_cast<std::uint32_t>(copies.size());
+            std::size_t array = allocate(count * sizeof(ast::Ref<Item>), alignof(ast::Ref<Item>));
+            std::size_t self = allocate(sizeof(T), alignof(T));
+            auto *refs = reinterpret_cast<ast::Ref<Item> *>(block + array);
+            for (std::uint32_t i = 0; i < count; ++i) {
+                new(refs + i) ast::Ref<Item>(at<Item>(copies[i]));
+            }
+            T *copy = new(block + self) T();
+            (copy->*field).adopt(refs, count);
+            return stamp(copy, node);
+        }
+    };
+
+    [[noreturn]] void malformed(const char *why) {
+        throw std::runtime_error(std::string("malformed AST image: ") + why);
+    }
+}
+
+void writeAstImage(const ParsedProgram &program, std::ostream &os) {
+    TreeCopier tree;
+    std::size_t root = tree.copy(program.funcs);
+
+    std::string ends;
+    std::string names;
+    for (ast::SymbolId id = 0; id < program.names.size(); ++id) {
+        std::string_view name = program.names.name(id);
+        names.append(name.data(), name.size());
+        auto end = static_cast<std::uint32_t>(names.size());
+        ends.append(reinterpret_cast<const char *>(&end), sizeof(end));
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.nameCount = static_cast<std::uint32_t>(program.names.size());
+    header.nameBytes = static_cast<std::uint32_t>(names.size());
+    nodeSizes(header.nodeSizes);
+    header.treeBytes = tree.size();
+    header.root = root;
+
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    os.write(tree.data(), static_cast<std::streamsize>(tree.size()));
+    os.write(ends.data(), static_cast<std::streamsize>(ends.size()));
+    os.write(names.data(), static_cast<std::streamsize>(names.size()));
+}
+
+std::unique_ptr<ParsedProgram> loadAstImage(Source image) {
+    trace::Span span("load ast");
+    auto program = std::make_unique<ParsedProgram>();
+    program->source = std::move(image);
+    const char *bytes = program->source.data();
+    std::size_t size = program->source.size();
+
+    Header header;
+    if (size < sizeof(header)) {
+        throw std::runtime_error("not an AST image");
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("not an AST image");
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("AST image of another version");
+    }
+    std::uint8_t sizes[28];
+    nodeSizes(sizes);
+    if (header.byteOrder != BYTE_ORDER_MARK || std::memcmp(header.nodeSizes, sizes, sizeof(sizes)) != 0) {
+        throw std::runtime_error("AST image of a build with another node layout");
+    }
+    // Checked one section at a time, so that no sum can wrap
+    std::size_t left = size - sizeof(header);
+    if (header.treeBytes > left || header.root > header.treeBytes ||
+        header.treeBytes - header.root < sizeof(ast::Funcs) || header.root % alignof(ast::Funcs) != 0) {
+        malformed("the tree is out of bounds");
+    }
+    left -= header.treeBytes;
+    if (left != std::uint64_t(header.nameCount) * sizeof(std::uint32_t) + header.nameBytes) {
+        malformed("the names do not fill the rest");
+    }
+
+    // Interned in order, so that each name gets the SymbolId it had when the image was written
+    const char *tree = bytes + sizeof(header);
+    const char *ends = tree + header.treeBytes;
+    const char *text = ends + std::size_t(header.nameCount) * sizeof(std::uint32_t);
+    std::uint32_t begin = 0;
+    for (std::uint32_t i = 0; i < header.nameCount; ++i) {
+        std::uint32_t end;
+        std::memcpy(&end, ends + std::size_t(i) * sizeof(end), sizeof(end));
+        if (end < begin || end > header.nameBytes) {
+            malformed("a name is out of bounds");
+        }
+        if (program->names.intern({text + begin, end - begin}) != i) {
+            malformed("a name is repeated");
+        }
+        begin = end;
+    }
+
+    auto *root = reinterpret_cast<ast::Funcs *>(program->source.data() + sizeof(header) + header.root);
+    if (root->kind != ast::NodeKind::Funcs) {
+        malformed("the root is not a list of functions");
+    }
+    program->funcs = root;
+    return program;
+}
@@ -0,0 +1,34 @@
+#ifndef ASTIMAGE_HPP
+#define ASTIMAGE_HPP
+
+#include <memory>
+#include <ostream>
+
+#include "frontend.hpp"
+
+/* Binary image of a parsed program
+ * Lets a program be checked, or read by other tools, without scanning and parsing it again. The image holds the
+ * nodes themselves, packed into one block along with the characters of the string literals. Since nodes reach
+ * their children and characters through Refs, which are distances rather than addresses, the block is used where
+ * it is mapped: loading only checks the header and interns the names.
+ *
+ *   header    64 bytes: "HW3AST" magic, u16 version, u32 byte order mark 0x01020304, u32 number of names,
+ *             u32 bytes of name text, u8 size of each node class by NodeKind (zero-padded to 28), u64 size of the
+ *             tree, u64 offset of the Funcs root in the tree
+ *   tree      the nodes, their lists and the string literal characters
+ *   names     u32 end offset of each name in the name text, in SymbolId order, then the name text
+ *
+ * Nodes are stored as this build lays them out, in the byte order of the machine, so an image is only loaded by a
+ * build with the same byte order and node sizes, as recorded in the header.
+ */
+
+// Writes the tree of program in the image format to os
+void writeAstImage(const ParsedProgram &program, std::ostream &os);
+
+// Loads the program held in image, which is usually a mapped file; the result keeps image alive, since its tree
+// lies in it. Throws std::runtime_error if image is not an image this build can load. The nodes are used as they
+// are, so an image must come from writeAstImage: the header guards against truncated images and other builds, not
+// against ones edited by hand.
+std::unique_ptr<ParsedProgram> loadAstImage(Source image);
+
+#endif //ASTIMAGE_HPP
@@ -0,0 +1,20 @@
+#include "Backend.hpp"
+
+namespace backend {
+    std::unordered_map<ast::SymbolId, Signature> signatures(ast::Funcs &funcs) {
+        std::unordered_map<ast::SymbolId, Signature> result;
+        for (auto &f: funcs.funcs) {
+            Signature &signature = result[f->id->value];
+            signature.returns = f->return_type->type;
+            for (auto &p: f->formals->formals) {
+                signature.params.push_back(p->type->type);
+            }
+        }
+        return result;
+    }
+
+    void Writer::flush() {
+        os.write(text.data(), static_cast<std::streamsize>(text.size()));
+        text.clear();
+    }
+}
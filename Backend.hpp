@@ -0,0 +1,80 @@
+#ifndef BACKEND_HPP
+#define BACKEND_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "nodes.hpp"
+
+/* What the backends that write a checked program as text share
+ * The LLVM IR and C writers look up the signature of every function before writing any, both spell the zero of a
+ * type the same way, and they and the assembly writer build their output with a Writer.
+ */
+namespace backend {
+    struct Signature {
+        ast::BuiltInType returns;
+        std::vector<ast::BuiltInType> params;
+    };
+
+    // Signature of every function of a program, by name
+    std::unordered_map<ast::SymbolId, Signature> signatures(ast::Funcs &funcs);
+
+    // Zero of a type as a constant of LLVM IR or of C
+    inline const char *zero(ast::BuiltInType type) {
+        return type == ast::BuiltInType::BOOL ? "false" : "0";
+    }
+
+    /* Output gathered from pieces of text and numbers, and written to a stream a buffer at a time
+     * A module is built from many small pieces; writing each to the stream would cost a call through the stream
+     * apiece, and holding the whole module would cost memory in proportion to the program, so the text of whole
+     * functions is gathered until there is a buffer of it.
+     */
+    class Writer {
+    public:
+        // Bytes gathered before they are written
+        static constexpr std::size_t BUFFERED = 1 << 16;
+
+        explicit Writer(std::ostream &os) : os(os) {}
+
+        template<typename... Pieces>
+        void put(const Pieces &... pieces) {
+            (append(text, pieces), ...);
+        }
+
+        static void append(std::string &out, const std::string &piece) { out += piece; }
+
+        static void append(std::string &out, std::string_view piece) { out += piece; }
+
+        static void append(std::string &out, const char *piece) { out += piece; }
+
+        static void append(std::string &out, char piece) { out += piece; }
+
+        template<typename Integer>
+        static void append(std::string &out, Integer piece) {
+            char digits[24];
+            out.append(digits, std::to_chars(digits, digits + sizeof(digits), piece).ptr);
+        }
+
+        // Writes the text gathered once it fills a buffer
+        void spill() {
+            if (text.size() >= BUFFERED) {
+                flush();
+            }
+        }
+
+        void flush();
+
+        // Gathered and not written yet
+        std::string text;
+
+    private:
+        std::ostream &os;
+    };
+}
+
+#endif //BACKEND_HPP
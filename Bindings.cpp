@@ -0,0 +1,19 @@
+#include "Bindings.hpp"
+
+std::size_t BindingStack::find(ast::SymbolId name) const {
+    std::size_t binding = names.size();
+    while (names[--binding] != name) {
+    }
+    return binding;
+}
+
+std::size_t BindingStack::open(ast::SymbolId name, bool ready) {
+    names.push_back(name);
+    done.push_back(ready);
+    return names.size() - 1;
+}
+
+void BindingStack::close(std::size_t size) {
+    names.resize(size);
+    done.resize(size);
+}
@@ -0,0 +1,83 @@
+#ifndef BINDINGS_HPP
+#define BINDINGS_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Interner.hpp"
+
+/* Variables visible where a backend is in a function of a checked tree
+ * The passes that walk the tree after SemanticParser (the bytecode lowering, the LLVM IR and C writers, constant
+ * folding) all track which declaration a name stands for, and whether that declaration's initializer is done: a
+ * variable read in its own initializer reads as 0. A BindingStack keeps the names and that state; Bindings adds the
+ * pass's own payload per variable, such as a register, a stack slot or a constant. Bindings are opened in order and
+ * closed together by a Scope when the block that declared them ends.
+ */
+class BindingStack {
+public:
+    // Number of open bindings
+    std::size_t size() const { return names.size(); }
+
+    // Innermost open binding of name, which SemanticParser has checked to be declared
+    std::size_t find(ast::SymbolId name) const;
+
+    // Whether the initializer of binding is done; until then the variable reads as 0
+    bool ready(std::size_t binding) const { return done[binding]; }
+
+    void setReady(std::size_t binding) { done[binding] = true; }
+
+protected:
+    std::size_t open(ast::SymbolId name, bool ready);
+
+    // Closes every binding from the one at size on
+    void close(std::size_t size);
+
+private:
+    std::vector<ast::SymbolId> names;
+    std::vector<bool> done;
+};
+
+template<typename T>
+class Bindings : public BindingStack {
+public:
+    /* Closes the bindings opened after its construction when destroyed */
+    class Scope {
+    public:
+        explicit Scope(Bindings &bindings) : bindings(bindings), size(bindings.size()) {}
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() { bindings.close(size); }
+
+    private:
+        Bindings &bindings;
+        std::size_t size;
+    };
+
+    // Opens a binding of name holding value and returns it. One that is not ready yet is made so by setReady once
+    // its initializer is done
+    std::size_t declare(ast::SymbolId name, T value, bool ready) {
+        values.push_back(std::move(value));
+        return open(name, ready);
+    }
+
+    // Closes every binding, before the next function
+    void clear() { close(0); }
+
+    T &operator[](std::size_t binding) { return values[binding]; }
+
+    const T &operator[](std::size_t binding) const { return values[binding]; }
+
+private:
+    std::vector<T> values;
+
+    void close(std::size_t size) {
+        BindingStack::close(size);
+        values.erase(values.begin() + static_cast<std::ptrdiff_t>(size), values.end());
+    }
+};
+
+#endif //BINDINGS_HPP
@@ -0,0 +1,533 @@
+#include "Bytecode.hpp"
+#include "Bindings.hpp"
+#include "static_visitor.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <optional>
+#include <unordered_map>
+
+using ast::BuiltInType;
+
+namespace bytecode {
+    namespace {
+        const char *const OP_NAMES[] = {
+                "LOADI", "MOVE", "ADD", "SUB", "MUL", "DIV", "ADDI", "TRUNC", "JMP", "JT", "JF", "JEQ", "JNE", "JLT",
+                "JGT", "JLE", "JGE", "CALL", "RET", "RETV", "PRINT", "PRINTI"
+        };
+        // Operands of each op, for the listing: r register, i constant, @ jump target, f function, s string
+        const char *const OP_OPERANDS[] = {
+                "ri", "rr", "rrr", "rrr", "rrr", "rrr", "rri", "rr", "@", "@r", "@r", "@rr", "@rr", "@rr", "@rr",
+                "@rr", "@rr", "rfr", "r", "", "s", "r"
+        };
+        static_assert(sizeof(OP_NAMES) / sizeof(*OP_NAMES) == OPS, "a name for every op");
+        static_assert(sizeof(OP_OPERANDS) / sizeof(*OP_OPERANDS) == OPS, "operands for every op");
+
+        // Jump taken when a relation does not hold, by RelOpType
+        const ast::RelOpType NEGATED[] = {ast::NE, ast::EQ, ast::GE, ast::LE, ast::GT, ast::LT};
+
+        /* Variable visible where the lowering is */
+        struct Local {
+            std::int32_t reg;
+            BuiltInType type;
+        };
+
+        /* Jump target that may not be placed yet */
+        struct Label {
+            std::int32_t at = -1;
+            // Jumps to patch when it is placed
+            std::vector<std::size_t> uses;
+        };
+
+        /* Lowers the functions of a checked program one by one */
+        class Lowering : public StaticVisitor<Lowering, BuiltInType> {
+        public:
+            Lowering(Program &program, const ast::Interner &names)
+                    : program(program), names(names), print(names.find("print")), printi(names.find("printi")) {}
+
+            void lowerAll(ast::Funcs &funcs) {
+                for (auto &f: funcs.funcs) {
+                    ast::SymbolId id = f->id->value;
+                    if (names.name(id) == "main") {
+                        program.main = static_cast<std::uint32_t>(program.functions.size());
+                    }
+                    functions.emplace(id, static_cast<std::uint32_t>(program.functions.size()));
+                    returns.push_back(f->return_type->type);
+                    program.functions.push_back({std::string(names.name(id)), 0,
+                                                 static_cast<std::uint32_t>(f->formals->formals.size()), 0});
+                }
+                for (std::size_t i = 0; i < funcs.funcs.size(); ++i) {
+                    function(*funcs.funcs[i], program.functions[i], returns[i]);
+                }
+            }
+
+            // ----- Statements -----
+
+            // A block has a scope of its own
+            BuiltInType visit(ast::Statements &node) {
+                Scope scope(*this);
+                for (auto &st: node.statements) {
+                    statement(*st);
+                }
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::VarDecl &node) {
+                std::int32_t reg = localTop++;
+                top = localTop;
+                maxTop = std::max(maxTop, top);
+                std::size_t binding = bindings.declare(node.id->value, {reg, node.type->type}, false);
+                if (node.init_exp) {
+                    into(*node.init_exp, reg);
+                } else {
+                    emit(Op::LOADI, reg, 0);
+                }
+                bindings.setReady(binding);
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::Assign &node) {
+                into(*node.exp, bindings[bindings.find(node.id->value)].reg);
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::Return &node) {
+                if (node.exp) {
+                    emit(Op::RET, value(*node.exp).reg);
+                } else {
+                    emit(Op::RETV);
+                }
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::If &node) {
+                Label otherwise;
+                branch(*node.condition, false, otherwise);
+                nested(*node.then);
+                if (node.otherwise) {
+                    Label end;
+                    jump(Op::JMP, end);
+                    place(otherwise);
+                    nested(*node.otherwise);
+                    place(end);
+                } else {
+                    place(otherwise);
+                }
+                return BuiltInType::VOID;
+            }
+
+            // The condition is tested after the body, so that an iteration takes one jump
+            BuiltInType visit(ast::While &node) {
+                Label body;
+                Label check;
+                Label end;
+                Label *outerContinue = std::exchange(continueLabel, &check);
+                Label *outerBreak = std::exchange(breakLabel, &end);
+                jump(Op::JMP, check);
+                place(body);
+                nested(*node.body);
+                place(check);
+                branch(*node.condition, true, body);
+                place(end);
+                continueLabel = outerContinue;
+                breakLabel = outerBreak;
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::Break &) {
+                jump(Op::JMP, *breakLabel);
+                return BuiltInType::VOID;
+            }
+
+            BuiltInType visit(ast::Continue &) {
+                jump(Op::JMP, *continueLabel);
+                return BuiltInType::VOID;
+            }
+
+            // ----- Expressions -----
+            // Each leaves its value in want, or in a register of its choosing when want is ANY, and sets result to
+            // that register
+
+            BuiltInType visit(ast::Num &node) {
+                result = destination();
+                emit(Op::LOADI, result, node.value);
+                return BuiltInType::INT;
+            }
+
+            BuiltInType visit(ast::NumB &node) {
+                result = destination();
+                emit(Op::LOADI, result, node.value);
+                return BuiltInType::BYTE;
+            }
+
+            BuiltInType visit(ast::Bool &node) {
+                result = destination();
+                emit(Op::LOADI, result, node.value ? 1 : 0);
+                return BuiltInType::BOOL;
+            }
+
+            // Only an argument of print, which takes it from result as a string constant
+            BuiltInType visit(ast::String &node) {
+                result = static_cast<std::int32_t>(program.strings.size());
+                program.strings.emplace_back(node.value());
+                return BuiltInType::STRING;
+            }
+
+            BuiltInType visit(ast::ID &node) {
+                std::size_t binding = bindings.find(node.value);
+                const Local &local = bindings[binding];
+                if (!bindings.ready(binding)) {
+                    result = destination();
+                    emit(Op::LOADI, result, 0);
+                } else if (want == ANY) {
+                    result = local.reg;
+                } else {
+                    result = want;
+                    if (result != local.reg) {
+                        emit(Op::MOVE, result, local.reg);
+                    }
+                }
+                return local.type;
+            }
+
+            BuiltInType visit(ast::BinOp &node) {
+                std::int32_t target = want;
+                Value left = value(*node.left);
+                BuiltInType rightType;
+                std::int32_t dst;
+                std::optional<int> constant = literal(*node.right);
+                if ((node.op == ast::ADD || node.op == ast::SUB) && constant && *constant != INT_MIN) {
+                    rightType = node.right->kind == ast::NodeKind::Num ? BuiltInType::INT : BuiltInType::BYTE;
+                    dst = target == ANY ? temp() : target;
+                    emit(Op::ADDI, dst, left.reg, node.op == ast::ADD ? *constant : -*constant);
+                } else {
+                    Value right = value(*node.right);
+                    rightType = right.type;
+                    dst = target == ANY ? temp() : target;
+                    emit(static_cast<Op>(static_cast<int>(Op::ADD) + node.op), dst, left.reg, right.reg);
+                }
+                result = dst;
+                if (left.type == BuiltInType::BYTE && rightType == BuiltInType::BYTE) {
+                    emit(Op::TRUNC, dst, dst);
+                    return BuiltInType::BYTE;
+                }
+                return BuiltInType::INT;
+            }
+
+            BuiltInType visit(ast::RelOp &node) { return boolean(node); }
+
+            BuiltInType visit(ast::Not &node) { return boolean(node); }
+
+            BuiltInType visit(ast::And &node) { return boolean(node); }
+
+            BuiltInType visit(ast::Or &node) { return boolean(node); }
+
+            BuiltInType visit(ast::Cast &node) {
+                std::int32_t target = want;
+                if (node.target_type->type != BuiltInType::BYTE) {
+                    forward(*node.exp, target);
+                    return node.target_type->type;
+                }
+                Value from = value(*node.exp);
+                if (from.type == BuiltInType::BYTE) {
+                    result = from.reg;
+                    if (target != ANY && target != from.reg) {
+                        emit(Op::MOVE, target, from.reg);
+                        result = target;
+                    }
+                } else {
+                    result = target == ANY ? temp() : target;
+                    emit(Op::TRUNC, result, from.reg);
+                }
+                return BuiltInType::BYTE;
+            }
+
+            BuiltInType visit(ast::Call &node) {
+                std::int32_t target = want;
+                ast::SymbolId id = node.func_id->value;
+                const ast::List<ast::Exp> &args = node.args->exps;
+                if (id == print) {
+                    value(*args[0]);
+                    emit(Op::PRINT, result);
+                    return BuiltInType::VOID;
+                }
+                if (id == printi) {
+                    emit(Op::PRINTI, value(*args[0]).reg);
+                    return BuiltInType::VOID;
+                }
+
+                // Every argument goes straight into the register the callee's frame takes it from
+                std::uint32_t index = functions.at(id);
+                std::int32_t base = top;
+                std::int32_t count = static_cast<std::int32_t>(args.size());
+                for (std::int32_t i = 0; i < count; ++i) {
+                    top = base + count;
+                    maxTop = std::max(maxTop, top);
+                    into(*args[i], base + i);
+                }
+                result = target == ANY ? base : target;
+                top = result == base ? base + 1 : base;
+                maxTop = std::max(maxTop, top);
+                emit(Op::CALL, result, static_cast<std::int32_t>(index), base);
+                return returns[index];
+            }
+
+            // Never reached: only the nodes above are statements or expressions
+            BuiltInType visit(ast::Node &) { return BuiltInType::VOID; }
+
+        private:
+            static constexpr std::int32_t ANY = -1;
+
+            struct Value {
+                std::int32_t reg;
+                BuiltInType type;
+            };
+
+            /* Closes the bindings and frees the registers opened after its construction when destroyed */
+            class Scope {
+            public:
+                explicit Scope(Lowering &lowering)
+                        : lowering(lowering), bindings(lowering.bindings), localTop(lowering.localTop) {}
+
+                Scope(const Scope &) = delete;
+
+                Scope &operator=(const Scope &) = delete;
+
+                ~Scope() { lowering.localTop = lowering.top = localTop; }
+
+            private:
+                Lowering &lowering;
+                Bindings<Local>::Scope bindings;
+                std::int32_t localTop;
+            };
+
+            Program &program;
+            const ast::Interner &names;
+            std::optional<ast::SymbolId> print;
+            std::optional<ast::SymbolId> printi;
+            std::unordered_map<ast::SymbolId, std::uint32_t> functions;
+            std::vector<BuiltInType> returns;
+
+            Bindings<Local> bindings;
+            // Registers below localTop hold parameters and open locals; temporaries are taken from top up
+            std::int32_t localTop = 0;
+            std::int32_t top = 0;
+            std::int32_t maxTop = 0;
+            // Register the expression being lowered must leave its value in, or ANY
+            std::int32_t want = ANY;
+            // Register the last expression lowered left its value in
+            std::int32_t result = 0;
+            // Where continue and break jump in the innermost loop
+            Label *continueLabel = nullptr;
+            Label *breakLabel = nullptr;
+            // Code size when a label was last placed: a return there may still be jumped past
+            std::size_t labelled = 0;
+
+            void function(ast::FuncDecl &node, Function &function, BuiltInType returnType) {
+                function.entry = static_cast<std::uint32_t>(program.code.size());
+                bindings.clear();
+                std::int32_t reg = 0;
+                for (auto &p: node.formals->formals) {
+                    bindings.declare(p->id->value, {reg++, p->type->type}, true);
+                }
+                localTop = top = maxTop = reg;
+
+                // The body shares the function's scope
+                for (auto &st: node.body->statements) {
+                    statement(*st);
+                }
+                bool returned = program.code.size() > function.entry && labelled != program.code.size() &&
+                                (program.code.back().op == Op::RET || program.code.back().op == Op::RETV);
+                if (!returned && returnType == BuiltInType::VOID) {
+                    emit(Op::RETV);
+                } else if (!returned) {
+                    // Falling off the end of a function that returns a value returns 0
+                    std::int32_t zero = temp();
+                    emit(Op::LOADI, zero, 0);
+                    emit(Op::RET, zero);
+                }
+                function.registers = static_cast<std::uint32_t>(maxTop);
+            }
+
+            // Lowers a statement of a block; its temporaries are free again after it
+            void statement(ast::Statement &st) {
+                want = ANY;
+                dispatch(st);
+                top = localTop;
+            }
+
+            // The statement under an if, an else or a while has a scope of its own, as SemanticParser gives it
+            void nested(ast::Statement &st) {
+                Scope scope(*this);
+                statement(st);
+            }
+
+            std::int32_t temp() {
+                maxTop = std::max(maxTop, top + 1);
+                return top++;
+            }
+
+            std::int32_t destination() {
+                return want == ANY ? temp() : want;
+            }
+
+            Value value(ast::Exp &exp) {
+                want = ANY;
+                BuiltInType type = dispatch(exp);
+                return {result, type};
+            }
+
+            BuiltInType into(ast::Exp &exp, std::int32_t reg) {
+                want = reg;
+                return dispatch(exp);
+            }
+
+            // Lowers exp into target, or anywhere when target is ANY
+            BuiltInType forward(ast::Exp &exp, std::int32_t target) {
+                return target == ANY ? value(exp).type : into(exp, target);
+            }
+
+            static std::optional<int> literal(const ast::Exp &exp) {
+                if (exp.kind == ast::NodeKind::Num) {
+                    return static_cast<const ast::Num &>(exp).value;
+                }
+                if (exp.kind == ast::NodeKind::NumB) {
+                    return static_cast<const ast::NumB &>(exp).value;
+                }
+                return std::nullopt;
+            }
+
+            // A condition used as a value is lowered as jumps too, which store 1 or 0 once it is decided
+            BuiltInType boolean(ast::Exp &exp) {
+                std::int32_t dst = destination();
+                Label no;
+                Label end;
+                branch(exp, false, no);
+                emit(Op::LOADI, dst, 1);
+                jump(Op::JMP, end);
+                place(no);
+                emit(Op::LOADI, dst, 0);
+                place(end);
+                result = dst;
+                return BuiltInType::BOOL;
+            }
+
+            // Jumps to to when the condition exp is when, and falls through otherwise. The right operand of and and
+            // or is only evaluated when the left one does not decide
+            void branch(ast::Exp &exp, bool when, Label &to) {
+                std::int32_t saved = top;
+                switch (exp.kind) {
+                    case ast::NodeKind::Bool:
+                        if (static_cast<ast::Bool &>(exp).value == when) {
+                            jump(Op::JMP, to);
+                        }
+                        break;
+                    case ast::NodeKind::Not:
+                        branch(*static_cast<ast::Not &>(exp).exp, !when, to);
+                        break;
+                    case ast::NodeKind::And: {
+                        auto &node = static_cast<ast::And &>(exp);
+                        shortCircuit(*node.left, *node.right, false, when, to);
+                        break;
+                    }
+                    case ast::NodeKind::Or: {
+                        auto &node = static_cast<ast::Or &>(exp);
+                        shortCircuit(*node.left, *node.right, true, when, to);
+                        break;
+                    }
+                    case ast::NodeKind::RelOp: {
+                        auto &node = static_cast<ast::RelOp &>(exp);
+                        Value left = value(*node.left);
+                        Value right = value(*node.right);
+                        ast::RelOpType op = when ? node.op : NEGATED[node.op];
+                        jump(static_cast<Op>(static_cast<int>(Op::JEQ) + op), to, left.reg, right.reg);
+                        break;
+                    }
+                    default:
+                        jump(when ? Op::JT : Op::JF, to, value(exp).reg);
+                        break;
+                }
+                top = saved;
+            }
+
+            // Branches on left and right joined by and (decider false) or by or (decider true): left alone decides
+            // when it equals decider
+            void shortCircuit(ast::Exp &left, ast::Exp &right, bool decider, bool when, Label &to) {
+                if (when == decider) {
+                    branch(left, when, to);
+                    branch(right, when, to);
+                    return;
+                }
+                Label decided;
+                branch(left, decider, decided);
+                branch(right, when, to);
+                place(decided);
+            }
+
+            void emit(Op op, std::int32_t a = 0, std::int32_t b = 0, std::int32_t c = 0) {
+                program.code.push_back({op, a, b, c});
+            }
+
+            void jump(Op op, Label &to, std::int32_t b = 0, std::int32_t c = 0) {
+                if (to.at < 0) {
+                    to.uses.push_back(program.code.size());
+                }
+                emit(op, to.at, b, c);
+            }
+
+            void place(Label &label) {
+                label.at = static_cast<std::int32_t>(program.code.size());
+                for (std::size_t use: label.uses) {
+                    program.code[use].a = label.at;
+                }
+                label.uses.clear();
+                labelled = program.code.size();
+            }
+        };
+    }
+
+    Program lower(ast::Funcs &funcs, const ast::Interner &names) {
+        Program program;
+        Lowering(program, names).lowerAll(funcs);
+        return program;
+    }
+
+    void Program::disassemble(std::ostream &os) const {
+        char line[96];
+        for (std::size_t f = 0; f < functions.size(); ++f) {
+            const Function &function = functions[f];
+            std::size_t end = f + 1 < functions.size() ? functions[f + 1].entry : code.size();
+            os << function.name << " (" << function.params << " params, " << function.registers << " registers)\n";
+            for (std::size_t pc = function.entry; pc < end; ++pc) {
+                const Instruction &ins = code[pc];
+                std::size_t op = static_cast<std::size_t>(ins.op);
+                std::snprintf(line, sizeof(line), "%6zu  %-7s", pc, OP_NAMES[op]);
+                os << line;
+                const std::int32_t operands[] = {ins.a, ins.b, ins.c};
+                const char *kinds = OP_OPERANDS[op];
+                for (std::size_t i = 0; kinds[i] != '\0'; ++i) {
+                    os << (i ? ", " : " ");
+                    switch (kinds[i]) {
+                        case 'r':
+                            os << 'r' << operands[i];
+                            break;
+                        case '@':
+                            os << '@' << operands[i];
+                            break;
+                        case 'f':
+                            os << functions[operands[i]].name;
+                            break;
+                        case 's':
+                            os << '"' << strings[operands[i]] << '"';
+                            break;
+                        default:
+                            os << operands[i];
+                            break;
+                    }
+                }
+                os << '\n';
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef BYTECODE_HPP
+#define BYTECODE_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "nodes.hpp"
+
+/* Register bytecode for FanC programs, run by --run (see Vm)
+ * Every value is a 32-bit integer in a register of the function's frame: bools are 0 or 1, and bytes stay within
+ * 0..255 because every byte result is truncated. Registers are numbered as SemanticParser numbers frame offsets:
+ * the parameter at offset -1 - i is register i, and the local at offset i is register params + i, so locals of
+ * scopes that are closed share registers as they share offsets. Temporaries come after the locals. A call's
+ * arguments are evaluated into the registers at the top of the caller's frame, where the callee's frame then
+ * starts, so they need no copy.
+ */
+namespace bytecode {
+
+    enum class Op : std::uint8_t {
+        // r[a] = b
+        LOADI,
+        // r[a] = r[b]
+        MOVE,
+        // r[a] = r[b] op r[c], wrapping at 32 bits. DIV stops the program with an error when r[c] is 0
+        ADD,
+        SUB,
+        MUL,
+        DIV,
+        // r[a] = r[b] + c
+        ADDI,
+        // r[a] = r[b] & 0xff, for byte results
+        TRUNC,
+        // Jump to a
+        JMP,
+        // Jump to a if r[b] is true (JT) or false (JF)
+        JT,
+        JF,
+        // Jump to a if r[b] op r[c]
+        JEQ,
+        JNE,
+        JLT,
+        JGT,
+        JLE,
+        JGE,
+        // r[a] = the result of function b, whose frame starts at register c of this one
+        CALL,
+        // Return r[a]
+        RET,
+        // Return nothing
+        RETV,
+        // Print string constant a, then a newline (the print intrinsic)
+        PRINT,
+        // Print r[a] in decimal, then a newline (the printi intrinsic)
+        PRINTI
+    };
+
+    constexpr std::size_t OPS = static_cast<std::size_t>(Op::PRINTI) + 1;
+
+    /* One instruction; jump targets are indices into the program's code */
+    struct Instruction {
+        Op op;
+        std::int32_t a;
+        std::int32_t b;
+        std::int32_t c;
+    };
+
+    struct Function {
+        std::string name;
+        // Index of the first instruction
+        std::uint32_t entry;
+        std::uint32_t params;
+        // Size of the frame: parameters, the most locals open at once and temporaries
+        std::uint32_t registers;
+    };
+
+    struct Program {
+        std::vector<Instruction> code;
+        std::vector<Function> functions;
+        std::vector<std::string> strings;
+        // Index of main in functions
+        std::uint32_t main = 0;
+
+        // Writes the code, function by function, one instruction per line
+        void disassemble(std::ostream &os) const;
+    };
+
+    // Lowers a program that SemanticParser has checked without errors; the tree of any other program is not
+    // guaranteed to lower
+    Program lower(ast::Funcs &funcs, const ast::Interner &names);
+}
+
+#endif //BYTECODE_HPP
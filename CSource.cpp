@@ -0,0 +1,441 @@
+#include "CSource.hpp"
+#include "Backend.hpp"
+#include "Bindings.hpp"
+#include "static_visitor.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using ast::BuiltInType;
+using backend::Signature;
+using backend::zero;
+
+namespace c_source {
+    namespace {
+        const char *const RELATIONS[] = {"==", "!=", "<", ">", "<=", ">="};
+        const char *const OPERATORS[] = {"+", "-", "*", "/"};
+        // Function doing each BinOpType on ints, wrapping at 32 bits
+        const char *const INT_OPERATIONS[] = {"hw3_add", "hw3_sub", "hw3_mul", "hw3_div"};
+
+        // What every program includes, and the functions its code calls
+        const char *const RUNTIME = R"(/* FanC program, written by hw3 --emit-c */
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static inline void hw3_divzero(void) {
+    puts("Error division by zero");
+    exit(0);
+}
+
+static inline int32_t hw3_add(int32_t a, int32_t b) { return (int32_t) ((uint32_t) a + (uint32_t) b); }
+
+static inline int32_t hw3_sub(int32_t a, int32_t b) { return (int32_t) ((uint32_t) a - (uint32_t) b); }
+
+static inline int32_t hw3_mul(int32_t a, int32_t b) { return (int32_t) ((uint32_t) a * (uint32_t) b); }
+
+/* INT32_MIN / -1 wraps like the other operations instead of trapping */
+static inline int32_t hw3_div(int32_t a, int32_t b) {
+    if (b == 0) {
+        hw3_divzero();
+    }
+    return b == -1 ? (int32_t) (0u - (uint32_t) a) : a / b;
+}
+
+static inline uint8_t hw3_divb(uint8_t a, uint8_t b) {
+    if (b == 0) {
+        hw3_divzero();
+    }
+    return (uint8_t) (a / b);
+}
+
+static inline void hw3_printi(int32_t i) { printf("%" PRId32 "\n", i); }
+)";
+
+        const char *typeName(BuiltInType type) {
+            switch (type) {
+                case BuiltInType::INT:
+                    return "int32_t";
+                case BuiltInType::BYTE:
+                    return "uint8_t";
+                case BuiltInType::BOOL:
+                    return "bool";
+                default:
+                    return "void";
+            }
+        }
+
+        /* C expression of a FanC expression */
+        struct Value {
+            std::string text;
+            BuiltInType type;
+            // Whether evaluating it may print or exit, so that it must keep its place in the order of evaluation
+            bool effects;
+        };
+
+        /* Writes the functions of a checked program one by one */
+        class Codegen : public StaticVisitor<Codegen, Value>, private backend::Writer {
+        public:
+            Codegen(const ast::Interner &names, std::ostream &os)
+                    : Writer(os), names(names), print(names.find("print")), printi(names.find("printi")) {}
+
+            void module(ast::Funcs &funcs) {
+                text += RUNTIME;
+                text += '\n';
+                signatures = backend::signatures(funcs);
+                for (auto &f: funcs.funcs) {
+                    prototype(f->id->value, signatures.at(f->id->value));
+                    text += ";\n";
+                }
+                for (auto &f: funcs.funcs) {
+                    function(*f);
+                    spill();
+                }
+                text += "\nint main(void) {\n    fanc_main();\n    return 0;\n}\n";
+                flush();
+            }
+
+            // ----- Statements -----
+
+            // A block has a scope of its own
+            Value visit(ast::Statements &node) {
+                line("{");
+                block(node);
+                line("}");
+                return none();
+            }
+
+            Value visit(ast::VarDecl &node) {
+                BuiltInType type = node.type->type;
+                std::size_t binding = bindings.declare(node.id->value, type, false);
+                std::string init = node.init_exp ? value(*node.init_exp).text : zero(type);
+                line(typeName(type), " v_", names.name(node.id->value), " = ", init, ';');
+                bindings.setReady(binding);
+                return none();
+            }
+
+            Value visit(ast::Assign &node) {
+                line("v_", names.name(node.id->value), " = ", value(*node.exp).text, ';');
+                return none();
+            }
+
+            Value visit(ast::Return &node) {
+                if (node.exp) {
+                    line("return ", value(*node.exp).text, ';');
+                } else {
+                    line("return;");
+                }
+                return none();
+            }
+
+            Value visit(ast::If &node) {
+                line("if (", value(*node.condition).text, ") {");
+                nested(*node.then);
+                if (node.otherwise) {
+                    line("} else {");
+                    nested(*node.otherwise);
+                }
+                line("}");
+                return none();
+            }
+
+            Value visit(ast::While &node) {
+                line("while (", value(*node.condition).text, ") {");
+                nested(*node.body);
+                line("}");
+                return none();
+            }
+
+            Value visit(ast::Break &) {
+                line("break;");
+                return none();
+            }
+
+            Value visit(ast::Continue &) {
+                line("continue;");
+                return none();
+            }
+
+            // ----- Expressions -----
+
+            // Folding leaves negative numbers, among them INT32_MIN, which C cannot write as a literal
+            Value visit(ast::Num &node) {
+                if (node.value == INT32_MIN) {
+                    return {"INT32_MIN", BuiltInType::INT, false};
+                }
+                return {node.value < 0 ? '(' + std::to_string(node.value) + ')' : std::to_string(node.value),
+                        BuiltInType::INT, false};
+            }
+
+            Value visit(ast::NumB &node) {
+                return {std::to_string(node.value), BuiltInType::BYTE, false};
+            }
+
+            Value visit(ast::Bool &node) {
+                return {node.value ? "true" : "false", BuiltInType::BOOL, false};
+            }
+
+            // Only an argument of print
+            Value visit(ast::String &node) {
+                std::string literal = "\"";
+                for (char c: node.value()) {
+                    auto byte = static_cast<unsigned char>(c);
+                    // ? is escaped for trigraphs
+                    if (c == '"' || c == '\\' || c == '?' || byte < 0x20 || byte >= 0x7f) {
+                        char escaped[5];
+                        std::snprintf(escaped, sizeof(escaped), "\\%03o", byte);
+                        literal += escaped;
+                    } else {
+                        literal += c;
+                    }
+                }
+                literal += '"';
+                return {literal, BuiltInType::STRING, false};
+            }
+
+            Value visit(ast::ID &node) {
+                std::size_t binding = bindings.find(node.value);
+                BuiltInType type = bindings[binding];
+                if (!bindings.ready(binding)) {
+                    return {zero(type), type, false};
+                }
+                return {"v_" + std::string(names.name(node.value)), type, false};
+            }
+
+            Value visit(ast::BinOp &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                bool effects = node.op == ast::DIV || left.effects || right.effects;
+                std::string order = sequence({&left, &right});
+                std::string result;
+                if (left.type == BuiltInType::BYTE && right.type == BuiltInType::BYTE) {
+                    result = node.op == ast::DIV
+                             ? "hw3_divb(" + left.text + ", " + right.text + ")"
+                             : "((uint8_t) (" + left.text + ' ' + OPERATORS[node.op] + ' ' + right.text + "))";
+                    return {ordered(order, result), BuiltInType::BYTE, effects};
+                }
+                result = std::string(INT_OPERATIONS[node.op]) + '(' + left.text + ", " + right.text + ')';
+                return {ordered(order, result), BuiltInType::INT, effects};
+            }
+
+            // Bytes promote to int, which compares them as FanC does, unsigned
+            Value visit(ast::RelOp &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                std::string order = sequence({&left, &right});
+                std::string result = '(' + left.text + ' ' + RELATIONS[node.op] + ' ' + right.text + ')';
+                return {ordered(order, result), BuiltInType::BOOL, left.effects || right.effects};
+            }
+
+            Value visit(ast::Not &node) {
+                Value operand = value(*node.exp);
+                return {"(!" + operand.text + ')', BuiltInType::BOOL, operand.effects};
+            }
+
+            // && and || evaluate their left operand first and the right one only when it does not decide
+            Value visit(ast::And &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                return {'(' + left.text + " && " + right.text + ')', BuiltInType::BOOL, left.effects || right.effects};
+            }
+
+            Value visit(ast::Or &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                return {'(' + left.text + " || " + right.text + ')', BuiltInType::BOOL, left.effects || right.effects};
+            }
+
+            Value visit(ast::Cast &node) {
+                Value from = value(*node.exp);
+                BuiltInType to = node.target_type->type;
+                if (from.type == to) {
+                    return from;
+                }
+                return {"((" + std::string(typeName(to)) + ") " + from.text + ')', to, from.effects};
+            }
+
+            Value visit(ast::Call &node) {
+                ast::SymbolId id = node.func_id->value;
+                const ast::List<ast::Exp> &args = node.args->exps;
+                if (id == print) {
+                    return {"puts(" + value(*args[0]).text + ')', BuiltInType::VOID, true};
+                }
+                if (id == printi) {
+                    return {"hw3_printi(" + value(*args[0]).text + ')', BuiltInType::VOID, true};
+                }
+
+                std::vector<Value> values;
+                values.reserve(args.size());
+                for (auto &arg: args) {
+                    values.push_back(value(*arg));
+                }
+                std::vector<Value *> operands;
+                for (Value &v: values) {
+                    operands.push_back(&v);
+                }
+                std::string order = sequence(operands);
+                std::string call = "fanc_" + std::string(names.name(id)) + '(';
+                for (std::size_t i = 0; i < values.size(); ++i) {
+                    call += (i ? ", " : "");
+                    call += values[i].text;
+                }
+                call += ')';
+                return {ordered(order, call), signatures.at(id).returns, true};
+            }
+
+            // Never reached: only the nodes above are statements or expressions
+            Value visit(ast::Node &) { return none(); }
+
+        private:
+            using Scope = Bindings<BuiltInType>::Scope;
+
+            const ast::Interner &names;
+            std::optional<ast::SymbolId> print;
+            std::optional<ast::SymbolId> printi;
+            std::unordered_map<ast::SymbolId, Signature> signatures;
+
+            // The function being written: the declarations of its temporaries, which go first, and its code
+            std::string temporaries;
+            std::string code;
+            // The type of each variable visible where the code is written
+            Bindings<BuiltInType> bindings;
+            std::uint32_t temps = 0;
+            // Nesting of the code being written, in levels of indentation
+            int depth = 0;
+
+            void prototype(ast::SymbolId name, const Signature &signature) {
+                put("static ", typeName(signature.returns), " fanc_", names.name(name), '(');
+                if (signature.params.empty()) {
+                    put("void");
+                }
+                for (std::size_t i = 0; i < signature.params.size(); ++i) {
+                    put(i ? ", " : "", typeName(signature.params[i]));
+                }
+                put(')');
+            }
+
+            void function(ast::FuncDecl &node) {
+                const Signature &signature = signatures.at(node.id->value);
+                temporaries.clear();
+                code.clear();
+                bindings.clear();
+                temps = 0;
+                depth = 1;
+
+                put("\nstatic ", typeName(signature.returns), " fanc_", names.name(node.id->value), '(');
+                if (signature.params.empty()) {
+                    put("void");
+                }
+                for (std::size_t i = 0; i < signature.params.size(); ++i) {
+                    ast::SymbolId param = node.formals->formals[i]->id->value;
+                    put(i ? ", " : "", typeName(signature.params[i]), " v_", names.name(param));
+                    bindings.declare(param, signature.params[i], true);
+                }
+                put(") {\n");
+
+                // The body shares the function's scope
+                for (auto &st: node.body->statements) {
+                    statement(*st);
+                }
+                // Falling off the end of a function that returns a value returns 0
+                if (signature.returns != BuiltInType::VOID) {
+                    line("return ", zero(signature.returns), ';');
+                }
+                text += temporaries;
+                text += code;
+                text += "}\n";
+            }
+
+            Value none() {
+                return {"", BuiltInType::VOID, false};
+            }
+
+            Value value(ast::Exp &exp) {
+                return dispatch(exp);
+            }
+
+            // A call is a statement of its own; every other statement writes its own lines
+            void statement(ast::Statement &st) {
+                if (st.kind == ast::NodeKind::Call) {
+                    line(value(static_cast<ast::Call &>(st)).text, ';');
+                } else {
+                    dispatch(st);
+                }
+            }
+
+            void block(ast::Statements &node) {
+                Scope scope(bindings);
+                ++depth;
+                for (auto &st: node.statements) {
+                    statement(*st);
+                }
+                --depth;
+            }
+
+            // The statement under an if, an else or a while, inside the braces its line opened, with a scope of
+            // its own, as SemanticParser gives it
+            void nested(ast::Statement &st) {
+                if (st.kind == ast::NodeKind::Statements) {
+                    block(static_cast<ast::Statements &>(st));
+                    return;
+                }
+                Scope scope(bindings);
+                ++depth;
+                statement(st);
+                --depth;
+            }
+
+            // Keeps FanC's left to right evaluation among operands that C evaluates in no particular order: when
+            // more than one has effects, all but the last of those are evaluated into temporaries first. Returns
+            // the assignments, to be put before the expression of the operands with ordered
+            std::string sequence(const std::vector<Value *> &operands) {
+                std::size_t effects = std::count_if(operands.begin(), operands.end(),
+                                                    [](const Value *v) { return v->effects; });
+                std::string order;
+                for (Value *v: operands) {
+                    if (effects < 2) {
+                        break;
+                    }
+                    if (!v->effects) {
+                        continue;
+                    }
+                    std::string temp = "t" + std::to_string(temps++);
+                    temporaries += "    ";
+                    temporaries += typeName(v->type);
+                    temporaries += ' ';
+                    temporaries += temp;
+                    temporaries += ";\n";
+                    order += temp;
+                    order += " = ";
+                    order += v->text;
+                    order += ", ";
+                    v->text = temp;
+                    --effects;
+                }
+                return order;
+            }
+
+            static std::string ordered(const std::string &order, const std::string &expression) {
+                return order.empty() ? expression : '(' + order + expression + ')';
+            }
+
+            // Writes one line of code from its pieces
+            template<typename... Pieces>
+            void line(const Pieces &... pieces) {
+                code.append(4 * depth, ' ');
+                (append(code, pieces), ...);
+                code += '\n';
+            }
+        };
+    }
+
+    void emit(ast::Funcs &funcs, const ast::Interner &names, std::ostream &os) {
+        Codegen(names, os).module(funcs);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef C_SOURCE_HPP
+#define C_SOURCE_HPP
+
+#include <ostream>
+
+#include "nodes.hpp"
+
+/* C for FanC programs, written by --emit-c
+ * A visitor over the checked tree, as SemanticParser is, writes the program as one C99 translation unit for the
+ * system C compiler, a lighter way to a native build than LLVM:
+ *     hw3 --emit-c < prog.in > prog.c && cc -O2 prog.c -o prog
+ * The code keeps the program's shape: FanC's if, while, break, continue and short-circuiting and and or are C's
+ * own. Types map to int32_t (int), uint8_t (byte) and bool. Byte arithmetic is truncated back to eight bits; int
+ * arithmetic goes through small inline functions that wrap in unsigned arithmetic, as C leaves signed overflow
+ * undefined, and division checks its divisor, printing "Error division by zero" and exiting on zero. C does not
+ * order the evaluation of operands and arguments, so where more than one has effects (calls, which may print, and
+ * divisions) the earlier ones are evaluated into temporaries first with the comma operator. Identifiers are prefixed
+ * (fanc_ for functions, v_ for variables) to stay clear of C keywords and the C library.
+ */
+namespace c_source {
+    // Writes a program that SemanticParser has checked without errors to os as C
+    void emit(ast::Funcs &funcs, const ast::Interner &names, std::ostream &os);
+}
+
+#endif //C_SOURCE_HPP
@@ -0,0 +1,353 @@
+#include "Folding.hpp"
+#include "Bindings.hpp"
+#include "static_visitor.hpp"
+
+#include <optional>
+#include <unordered_set>
+
+using ast::BuiltInType;
+
+namespace folding {
+    namespace {
+        std::int32_t wrap(std::uint32_t value) {
+            return static_cast<std::int32_t>(value);
+        }
+
+        // Value of a literal, with true as 1 and false as 0
+        std::optional<int> valueOf(const ast::Exp &exp) {
+            switch (exp.kind) {
+                case ast::NodeKind::Num:
+                    return static_cast<const ast::Num &>(exp).value;
+                case ast::NodeKind::NumB:
+                    return static_cast<const ast::NumB &>(exp).value;
+                case ast::NodeKind::Bool:
+                    return static_cast<const ast::Bool &>(exp).value ? 1 : 0;
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        /* Variable visible where the tree is folded */
+        struct Local {
+            BuiltInType type;
+            // The value it holds wherever it is read, if it is a constant
+            std::optional<int> value;
+        };
+
+        /* Folds the functions of a checked program one by one; visiting an expression returns what replaces it */
+        class Folder : public StaticVisitor<Folder, ast::Exp *> {
+        public:
+            explicit Folder(ast::Arena &arena) : arena(arena) {}
+
+            Counters counters{0, 0, 0, 0};
+
+            void function(ast::FuncDecl &node) {
+                bindings.clear();
+                assigned.clear();
+                for (auto &st: node.body->statements) {
+                    collectAssigned(*st);
+                }
+                for (auto &p: node.formals->formals) {
+                    bindings.declare(p->id->value, {p->type->type, std::nullopt}, true);
+                }
+                block(*node.body);
+            }
+
+            // ----- Statements -----
+
+            ast::Exp *visit(ast::Statements &node) {
+                block(node);
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::VarDecl &node) {
+                declare(node);
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::Assign &node) {
+                node.exp = fold(*node.exp);
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::Return &node) {
+                if (node.exp) {
+                    node.exp = fold(*node.exp);
+                }
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::If &node) {
+                node.condition = fold(*node.condition);
+                nested(*node.then);
+                if (node.otherwise) {
+                    nested(*node.otherwise);
+                }
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::While &node) {
+                node.condition = fold(*node.condition);
+                nested(*node.body);
+                return nullptr;
+            }
+
+            ast::Exp *visit(ast::Break &) { return nullptr; }
+
+            ast::Exp *visit(ast::Continue &) { return nullptr; }
+
+            // ----- Expressions -----
+
+            ast::Exp *visit(ast::Num &node) { return &node; }
+
+            ast::Exp *visit(ast::NumB &node) { return &node; }
+
+            ast::Exp *visit(ast::Bool &node) { return &node; }
+
+            ast::Exp *visit(ast::String &node) { return &node; }
+
+            ast::Exp *visit(ast::ID &node) {
+                std::size_t binding = bindings.find(node.value);
+                const Local &local = bindings[binding];
+                if (!bindings.ready(binding)) {
+                    ++counters.propagated;
+                    return literal(local.type, 0, node.line);
+                }
+                if (local.value) {
+                    ++counters.propagated;
+                    return literal(local.type, *local.value, node.line);
+                }
+                return &node;
+            }
+
+            ast::Exp *visit(ast::BinOp &node) {
+                node.left = fold(*node.left);
+                node.right = fold(*node.right);
+                std::optional<int> left = valueOf(*node.left);
+                std::optional<int> right = valueOf(*node.right);
+                if (node.op == ast::DIV && right == 0) {
+                    ++counters.zeroDivisions;
+                    return &node;
+                }
+                if (!left || !right) {
+                    return &node;
+                }
+                auto l = static_cast<std::uint32_t>(*left);
+                auto r = static_cast<std::uint32_t>(*right);
+                std::int32_t result = 0;
+                switch (node.op) {
+                    case ast::ADD:
+                        result = wrap(l + r);
+                        break;
+                    case ast::SUB:
+                        result = wrap(l - r);
+                        break;
+                    case ast::MUL:
+                        result = wrap(l * r);
+                        break;
+                    case ast::DIV:
+                        // INT_MIN / -1 wraps, as in the VM
+                        result = *right == -1 ? wrap(0u - l) : *left / *right;
+                        break;
+                }
+                bool bytes = node.left->kind == ast::NodeKind::NumB && node.right->kind == ast::NodeKind::NumB;
+                ++counters.folded;
+                return literal(bytes ? BuiltInType::BYTE : BuiltInType::INT, result, node.line);
+            }
+
+            // Bytes compare as ints, being all non-negative
+            ast::Exp *visit(ast::RelOp &node) {
+                node.left = fold(*node.left);
+                node.right = fold(*node.right);
+                std::optional<int> left = valueOf(*node.left);
+                std::optional<int> right = valueOf(*node.right);
+                if (!left || !right) {
+                    return &node;
+                }
+                bool result = false;
+                switch (node.op) {
+                    case ast::EQ:
+                        result = *left == *right;
+                        break;
+                    case ast::NE:
+                        result = *left != *right;
+                        break;
+                    case ast::LT:
+                        result = *left < *right;
+                        break;
+                    case ast::GT:
+                        result = *left > *right;
+                        break;
+                    case ast::LE:
+                        result = *left <= *right;
+                        break;
+                    case ast::GE:
+                        result = *left >= *right;
+                        break;
+                }
+                ++counters.folded;
+                return literal(BuiltInType::BOOL, result, node.line);
+            }
+
+            ast::Exp *visit(ast::Not &node) {
+                node.exp = fold(*node.exp);
+                std::optional<int> operand = valueOf(*node.exp);
+                if (!operand) {
+                    return &node;
+                }
+                ++counters.folded;
+                return literal(BuiltInType::BOOL, !*operand, node.line);
+            }
+
+            // true and x is x, and false and x is false; x and true is x too, but x and false still evaluates x
+            ast::Exp *visit(ast::And &node) {
+                node.left = fold(*node.left);
+                node.right = fold(*node.right);
+                std::optional<int> left = valueOf(*node.left);
+                if (left || valueOf(*node.right) == 1) {
+                    ++counters.folded;
+                    return left == 1 ? node.right : node.left;
+                }
+                return &node;
+            }
+
+            ast::Exp *visit(ast::Or &node) {
+                node.left = fold(*node.left);
+                node.right = fold(*node.right);
+                std::optional<int> left = valueOf(*node.left);
+                if (left || valueOf(*node.right) == 0) {
+                    ++counters.folded;
+                    return left == 0 ? node.right : node.left;
+                }
+                return &node;
+            }
+
+            ast::Exp *visit(ast::Cast &node) {
+                node.exp = fold(*node.exp);
+                std::optional<int> operand = valueOf(*node.exp);
+                if (!operand) {
+                    return &node;
+                }
+                ++counters.folded;
+                return literal(node.target_type->type, *operand, node.line);
+            }
+
+            ast::Exp *visit(ast::Call &node) {
+                for (auto &arg: node.args->exps) {
+                    arg = fold(*arg);
+                }
+                return &node;
+            }
+
+            // Never reached: only the nodes above are statements or expressions
+            ast::Exp *visit(ast::Node &) { return nullptr; }
+
+        private:
+            using Scope = Bindings<Local>::Scope;
+
+            ast::Arena &arena;
+            Bindings<Local> bindings;
+            // Names assigned anywhere in the function being folded; variables of these names are never constants
+            std::unordered_set<ast::SymbolId> assigned;
+
+            ast::Exp *fold(ast::Exp &exp) {
+                return dispatch(exp);
+            }
+
+            // A literal of type holding value, wrapped to eight bits for a byte
+            ast::Exp *literal(BuiltInType type, int value, int line) {
+                ast::Exp *node;
+                switch (type) {
+                    case BuiltInType::BYTE:
+                        node = arena.make<ast::NumB>(value & 0xff);
+                        break;
+                    case BuiltInType::BOOL:
+                        node = arena.make<ast::Bool>(value != 0);
+                        break;
+                    default:
+                        node = arena.make<ast::Num>(value);
+                        break;
+                }
+                node->line = line;
+                return node;
+            }
+
+            // Folds the declaration's initializer; returns whether the variable is a constant, whose reads are
+            // all replaced by its value
+            bool declare(ast::VarDecl &node) {
+                std::size_t binding = bindings.declare(node.id->value, {node.type->type, std::nullopt}, false);
+                std::optional<int> value = 0;
+                if (node.init_exp) {
+                    node.init_exp = fold(*node.init_exp);
+                    value = valueOf(*node.init_exp);
+                }
+                if (assigned.count(node.id->value) != 0) {
+                    value.reset();
+                }
+                bindings[binding].value = value;
+                bindings.setReady(binding);
+                return value.has_value();
+            }
+
+            // A block has a scope of its own. The declarations of constants in it are dropped
+            void block(ast::Statements &node) {
+                Scope scope(bindings);
+                ast::Ref<ast::Statement> *kept = node.statements.begin();
+                for (auto &st: node.statements) {
+                    if (st->kind == ast::NodeKind::VarDecl && declare(static_cast<ast::VarDecl &>(*st))) {
+                        ++counters.dropped;
+                        continue;
+                    }
+                    if (st->kind != ast::NodeKind::VarDecl) {
+                        dispatch(*st);
+                    }
+                    *kept++ = st;
+                }
+                std::size_t count = kept - node.statements.begin();
+                if (count != node.statements.size()) {
+                    node.statements.adopt(node.statements.begin(), static_cast<std::uint32_t>(count));
+                }
+            }
+
+            // The statement under an if, an else or a while has a scope of its own, as SemanticParser gives it
+            void nested(ast::Statement &st) {
+                Scope scope(bindings);
+                dispatch(st);
+            }
+
+            void collectAssigned(ast::Statement &st) {
+                switch (st.kind) {
+                    case ast::NodeKind::Assign:
+                        assigned.insert(static_cast<ast::Assign &>(st).id->value);
+                        break;
+                    case ast::NodeKind::Statements:
+                        for (auto &inner: static_cast<ast::Statements &>(st).statements) {
+                            collectAssigned(*inner);
+                        }
+                        break;
+                    case ast::NodeKind::If: {
+                        auto &node = static_cast<ast::If &>(st);
+                        collectAssigned(*node.then);
+                        if (node.otherwise) {
+                            collectAssigned(*node.otherwise);
+                        }
+                        break;
+                    }
+                    case ast::NodeKind::While:
+                        collectAssigned(*static_cast<ast::While &>(st).body);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        };
+    }
+
+    Counters fold(ast::Funcs &funcs, ast::Arena &arena) {
+        Folder folder(arena);
+        for (auto &f: funcs.funcs) {
+            folder.function(*f);
+        }
+        return folder.counters;
+    }
+}
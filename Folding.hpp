@@ -0,0 +1,36 @@
+#ifndef FOLDING_HPP
+#define FOLDING_HPP
+
+#include <cstdint>
+
+#include "nodes.hpp"
+
+/* Constant folding and propagation over a checked tree, before the backends run or write it
+ * Arithmetic, comparisons, not, and, or and casts whose operands are literals become literals, with the results
+ * wrapped as the VM wraps them: bytes to eight bits, ints to 32. A division by a literal zero is left in place, so
+ * that it fails where and when the program reaches it. And and or also fold when their left operand is a literal,
+ * or their right one is the literal that leaves the result to the left one, which is still evaluated.
+ * A local that is never assigned after its declaration holds the value of its initializer wherever it is read, so
+ * when that folds to a literal its reads become copies of the literal and the declaration, in a block, is dropped.
+ * Reads of a variable in its own initializer, which see 0, become 0. Statements are not folded: a branch on a
+ * literal condition keeps both arms.
+ */
+namespace folding {
+    /* What fold changed */
+    struct Counters {
+        // Expressions replaced by a literal or by one of their operands
+        std::uint64_t folded;
+        // Reads of a variable replaced by its value
+        std::uint64_t propagated;
+        // Declarations dropped after all their reads were
+        std::uint64_t dropped;
+        // Divisions by a literal zero, left to fail at run time
+        std::uint64_t zeroDivisions;
+    };
+
+    // Folds the tree of a program that SemanticParser has checked without errors in place, making the new literals
+    // in arena
+    Counters fold(ast::Funcs &funcs, ast::Arena &arena);
+}
+
+#endif //FOLDING_HPP
@@ -0,0 +1,75 @@
+#include "Interner.hpp"
+#include <cstring>
+#include <functional>
+
+namespace ast {
+
+    Interner::Interner() : slots(1024, EMPTY) {}
+
+    std::uint32_t Interner::hashText(std::string_view text) {
+        std::size_t h = std::hash<std::string_view>{}(text);
+        return static_cast<std::uint32_t>(h ^ (h >> 32));
+    }
+
+    std::size_t Interner::findSlot(std::string_view text, std::uint32_t hash) const {
+        std::size_t mask = slots.size() - 1;
+        std::size_t i = hash & mask;
+        while (slots[i] != EMPTY && (hashes[slots[i]] != hash || names[slots[i]] != text)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    const char *Interner::store(std::string_view text) {
+        if (text.size() > left) {
+            std::size_t size = text.size() > CHUNK_SIZE ? text.size() : CHUNK_SIZE;
+            chunks.emplace_back(new char[size]);
+            cur = chunks.back().get();
+            left = size;
+        }
+        char *result = cur;
+        std::memcpy(result, text.data(), text.size());
+        cur += text.size();
+        left -= text.size();
+        return result;
+    }
+
+    void Interner::grow() {
+        slots.assign(slots.size() * 2, EMPTY);
+        std::size_t mask = slots.size() - 1;
+        for (std::uint32_t id = 0; id < names.size(); ++id) {
+            std::size_t i = hashes[id] & mask;
+            while (slots[i] != EMPTY) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = id;
+        }
+    }
+
+    SymbolId Interner::intern(std::string_view text) {
+        std::uint32_t hash = hashText(text);
+        std::size_t i = findSlot(text, hash);
+        if (slots[i] != EMPTY) {
+            return slots[i];
+        }
+
+        if (2 * (names.size() + 1) > slots.size()) {
+            grow();
+            i = findSlot(text, hash);
+        }
+
+        auto id = static_cast<SymbolId>(names.size());
+        names.emplace_back(store(text), text.size());
+        hashes.push_back(hash);
+        slots[i] = id;
+        return id;
+    }
+
+    std::optional<SymbolId> Interner::find(std::string_view text) const {
+        std::size_t i = findSlot(text, hashText(text));
+        if (slots[i] == EMPTY) {
+            return std::nullopt;
+        }
+        return slots[i];
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef INTERNER_HPP
+#define INTERNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace ast {
+
+    /* Dense 32-bit handle of an interned identifier */
+    using SymbolId = std::uint32_t;
+
+    /* String interner
+     * Maps every distinct identifier spelling to a SymbolId, handed out densely from 0. The characters are copied
+     * once into chunked storage that never moves, so name() views stay valid for the interner's lifetime.
+     */
+    class Interner {
+    public:
+        Interner();
+
+        Interner(const Interner &) = delete;
+
+        Interner &operator=(const Interner &) = delete;
+
+        // Returns the id of text, interning it first if needed
+        SymbolId intern(std::string_view text);
+
+        // Returns the id of text if it has been interned, without interning it
+        std::optional<SymbolId> find(std::string_view text) const;
+
+        // Spelling of an interned id
+        std::string_view name(SymbolId id) const { return names[id]; }
+
+        // Number of distinct identifiers
+        std::size_t size() const { return names.size(); }
+
+    private:
+        static constexpr std::uint32_t EMPTY = UINT32_MAX;
+        static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+        // Open-addressing table of ids, linear probing, at most half full
+        std::vector<std::uint32_t> slots;
+        std::vector<std::uint32_t> hashes;
+        std::vector<std::string_view> names;
+
+        std::vector<std::unique_ptr<char[]>> chunks;
+        char *cur = nullptr;
+        std::size_t left = 0;
+
+        static std::uint32_t hashText(std::string_view text);
+
+        std::size_t findSlot(std::string_view text, std::uint32_t hash) const;
+
+        const char *store(std::string_view text);
+
+        void grow();
+    };
+}
+
+#endif //INTERNER_HPP
@@ -0,0 +1,526 @@
+#include "LlvmIr.hpp"
+#include "Backend.hpp"
+#include "Bindings.hpp"
+#include "static_visitor.hpp"
+
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using ast::BuiltInType;
+using backend::Signature;
+using backend::zero;
+
+namespace llvm_ir {
+    namespace {
+        // icmp predicate of each RelOpType, on ints and on bytes, which are unsigned
+        const char *const SIGNED[] = {"eq", "ne", "slt", "sgt", "sle", "sge"};
+        const char *const UNSIGNED[] = {"eq", "ne", "ult", "ugt", "ule", "uge"};
+        // Instruction of each BinOpType; a division of ints is written apart, to wrap INT_MIN / -1
+        const char *const ARITHMETIC[] = {"add", "sub", "mul", "udiv"};
+
+        // Entry point and the runtime the program's code calls
+        const char *const RUNTIME = R"(
+define i32 @main() {
+entry:
+  call void @fanc_main()
+  ret i32 0
+}
+
+define internal void @hw3.divzero() cold noreturn {
+entry:
+  call i32 @puts(ptr @.divzero)
+  call void @exit(i32 0)
+  unreachable
+}
+
+declare i32 @puts(ptr)
+declare i32 @printf(ptr, ...)
+declare void @exit(i32) noreturn
+
+@.printi = private unnamed_addr constant [4 x i8] c"%d\0A\00"
+@.divzero = private unnamed_addr constant [23 x i8] c"Error division by zero\00"
+)";
+
+        const char *typeName(BuiltInType type) {
+            switch (type) {
+                case BuiltInType::INT:
+                    return "i32";
+                case BuiltInType::BYTE:
+                    return "i8";
+                case BuiltInType::BOOL:
+                    return "i1";
+                default:
+                    return "void";
+            }
+        }
+
+        /* Operand of an instruction: a constant, a register or a global, and its FanC type */
+        struct Value {
+            std::string text;
+            BuiltInType type;
+        };
+
+        /* Variable visible where the code is written */
+        struct Local {
+            // Number of its alloca
+            std::uint32_t slot;
+            BuiltInType type;
+        };
+
+        /* Writes the functions of a checked program one by one */
+        class Codegen : public StaticVisitor<Codegen, Value>, private backend::Writer {
+        public:
+            Codegen(const ast::Interner &names, std::ostream &os)
+                    : Writer(os), names(names), print(names.find("print")), printi(names.find("printi")) {}
+
+            void module(ast::Funcs &funcs) {
+                text += "; FanC program, written by hw3 --emit-llvm\n";
+                signatures = backend::signatures(funcs);
+                for (auto &f: funcs.funcs) {
+                    function(*f);
+                    spill();
+                }
+                text += RUNTIME;
+                for (std::size_t s = 0; s < strings.size(); ++s) {
+                    constant(s, strings[s]);
+                }
+                flush();
+            }
+
+            // ----- Statements -----
+
+            // A block has a scope of its own
+            Value visit(ast::Statements &node) {
+                Scope scope(bindings);
+                for (auto &st: node.statements) {
+                    dispatch(*st);
+                }
+                return none();
+            }
+
+            Value visit(ast::VarDecl &node) {
+                BuiltInType type = node.type->type;
+                std::uint32_t slot = allocate(type);
+                std::size_t binding = bindings.declare(node.id->value, {slot, type}, false);
+                Value init = node.init_exp ? convert(value(*node.init_exp), type) : Value{zero(type), type};
+                store(init, slot);
+                bindings.setReady(binding);
+                return none();
+            }
+
+            Value visit(ast::Assign &node) {
+                const Local &local = bindings[bindings.find(node.id->value)];
+                store(convert(value(*node.exp), local.type), local.slot);
+                return none();
+            }
+
+            Value visit(ast::Return &node) {
+                if (node.exp) {
+                    Value result = convert(value(*node.exp), returnType);
+                    terminate("ret ", typeName(returnType), ' ', result.text);
+                } else {
+                    terminate("ret void");
+                }
+                return none();
+            }
+
+            Value visit(ast::If &node) {
+                std::string then = label();
+                std::string end = label();
+                std::string otherwise = node.otherwise ? label() : end;
+                branch(*node.condition, then, otherwise);
+                place(then);
+                nested(*node.then);
+                if (node.otherwise) {
+                    jump(end);
+                    place(otherwise);
+                    nested(*node.otherwise);
+                }
+                place(end);
+                return none();
+            }
+
+            Value visit(ast::While &node) {
+                std::string check = label();
+                std::string body = label();
+                std::string end = label();
+                std::string *outerContinue = std::exchange(continueLabel, &check);
+                std::string *outerBreak = std::exchange(breakLabel, &end);
+                place(check);
+                branch(*node.condition, body, end);
+                place(body);
+                nested(*node.body);
+                jump(check);
+                place(end);
+                continueLabel = outerContinue;
+                breakLabel = outerBreak;
+                return none();
+            }
+
+            Value visit(ast::Break &) {
+                jump(*breakLabel);
+                return none();
+            }
+
+            Value visit(ast::Continue &) {
+                jump(*continueLabel);
+                return none();
+            }
+
+            // ----- Expressions -----
+
+            Value visit(ast::Num &node) {
+                return {std::to_string(node.value), BuiltInType::INT};
+            }
+
+            Value visit(ast::NumB &node) {
+                return {std::to_string(node.value), BuiltInType::BYTE};
+            }
+
+            Value visit(ast::Bool &node) {
+                return {node.value ? "true" : "false", BuiltInType::BOOL};
+            }
+
+            // Only an argument of print, which takes it as the address of a global constant
+            Value visit(ast::String &node) {
+                std::string global = "@.str." + std::to_string(strings.size());
+                strings.emplace_back(node.value());
+                return {global, BuiltInType::STRING};
+            }
+
+            Value visit(ast::ID &node) {
+                std::size_t binding = bindings.find(node.value);
+                const Local &local = bindings[binding];
+                if (!bindings.ready(binding)) {
+                    return {zero(local.type), local.type};
+                }
+                std::string result = temp();
+                line(result, " = load ", typeName(local.type), ", ptr %v", local.slot);
+                return {result, local.type};
+            }
+
+            Value visit(ast::BinOp &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                BuiltInType type = left.type == BuiltInType::BYTE && right.type == BuiltInType::BYTE
+                                   ? BuiltInType::BYTE : BuiltInType::INT;
+                left = convert(left, type);
+                right = convert(right, type);
+                const char *name = typeName(type);
+                if (node.op == ast::DIV) {
+                    std::string isZero = temp();
+                    std::string divide = label();
+                    line(isZero, " = icmp eq ", name, ' ', right.text, ", 0");
+                    terminate("br i1 ", isZero, ", label %divzero, label %", divide);
+                    divides = true;
+                    place(divide);
+                }
+                std::string result = temp();
+                if (node.op == ast::DIV && type == BuiltInType::INT) {
+                    // sdiv overflows on INT_MIN / -1, so dividing by -1 negates instead
+                    std::string minusOne = temp();
+                    std::string divisor = temp();
+                    std::string quotient = temp();
+                    std::string negated = temp();
+                    line(minusOne, " = icmp eq i32 ", right.text, ", -1");
+                    line(divisor, " = select i1 ", minusOne, ", i32 1, i32 ", right.text);
+                    line(quotient, " = sdiv i32 ", left.text, ", ", divisor);
+                    line(negated, " = sub i32 0, ", left.text);
+                    line(result, " = select i1 ", minusOne, ", i32 ", negated, ", i32 ", quotient);
+                } else {
+                    line(result, " = ", ARITHMETIC[node.op], ' ', name, ' ', left.text, ", ", right.text);
+                }
+                return {result, type};
+            }
+
+            Value visit(ast::RelOp &node) {
+                Value left = value(*node.left);
+                Value right = value(*node.right);
+                bool bytes = left.type == BuiltInType::BYTE && right.type == BuiltInType::BYTE;
+                BuiltInType type = bytes ? BuiltInType::BYTE : BuiltInType::INT;
+                left = convert(left, type);
+                right = convert(right, type);
+                std::string result = temp();
+                line(result, " = icmp ", (bytes ? UNSIGNED : SIGNED)[node.op], ' ', typeName(type), ' ', left.text,
+                     ", ", right.text);
+                return {result, BuiltInType::BOOL};
+            }
+
+            Value visit(ast::Not &node) {
+                Value operand = value(*node.exp);
+                std::string result = temp();
+                line(result, " = xor i1 ", operand.text, ", true");
+                return {result, BuiltInType::BOOL};
+            }
+
+            Value visit(ast::And &node) { return boolean(node); }
+
+            Value visit(ast::Or &node) { return boolean(node); }
+
+            Value visit(ast::Cast &node) {
+                Value from = value(*node.exp);
+                BuiltInType to = node.target_type->type;
+                if (from.type == BuiltInType::INT && to == BuiltInType::BYTE) {
+                    std::string result = temp();
+                    line(result, " = trunc i32 ", from.text, " to i8");
+                    return {result, to};
+                }
+                return convert(from, to);
+            }
+
+            Value visit(ast::Call &node) {
+                ast::SymbolId id = node.func_id->value;
+                const ast::List<ast::Exp> &args = node.args->exps;
+                if (id == print) {
+                    line("call i32 @puts(ptr ", value(*args[0]).text, ')');
+                    return none();
+                }
+                if (id == printi) {
+                    Value number = convert(value(*args[0]), BuiltInType::INT);
+                    line("call i32 (ptr, ...) @printf(ptr @.printi, i32 ", number.text, ')');
+                    return none();
+                }
+
+                const Signature &signature = signatures.at(id);
+                std::string list;
+                for (std::size_t i = 0; i < args.size(); ++i) {
+                    Value arg = convert(value(*args[i]), signature.params[i]);
+                    list += (i ? ", " : "");
+                    list += typeName(signature.params[i]);
+                    list += ' ';
+                    list += arg.text;
+                }
+                std::string callee = "@fanc_" + std::string(names.name(id));
+                if (signature.returns == BuiltInType::VOID) {
+                    line("call void ", callee, '(', list, ')');
+                    return none();
+                }
+                std::string result = temp();
+                line(result, " = call ", typeName(signature.returns), ' ', callee, '(', list, ')');
+                return {result, signature.returns};
+            }
+
+            // Never reached: only the nodes above are statements or expressions
+            Value visit(ast::Node &) { return none(); }
+
+        private:
+            using Scope = Bindings<Local>::Scope;
+
+            const ast::Interner &names;
+            std::optional<ast::SymbolId> print;
+            std::optional<ast::SymbolId> printi;
+            std::unordered_map<ast::SymbolId, Signature> signatures;
+            std::vector<std::string> strings;
+
+            // The function being written: its allocas, which go first in the entry block, and its code
+            std::string allocas;
+            std::string code;
+            BuiltInType returnType = BuiltInType::VOID;
+            Bindings<Local> bindings;
+            std::uint32_t slots = 0;
+            std::uint32_t temps = 0;
+            std::uint32_t labels = 0;
+            // Whether the current block still takes instructions, that is it has no terminator yet
+            bool open = true;
+            // Whether a division branches to the function's divzero block
+            bool divides = false;
+            // Where continue and break jump in the innermost loop
+            std::string *continueLabel = nullptr;
+            std::string *breakLabel = nullptr;
+
+            void function(ast::FuncDecl &node) {
+                const Signature &signature = signatures.at(node.id->value);
+                returnType = signature.returns;
+                allocas.clear();
+                code.clear();
+                bindings.clear();
+                slots = temps = labels = 0;
+                open = true;
+                divides = false;
+
+                put("\ndefine internal ", typeName(returnType), " @fanc_", names.name(node.id->value), '(');
+                for (std::size_t i = 0; i < signature.params.size(); ++i) {
+                    put(i ? ", " : "", typeName(signature.params[i]), " %p", i);
+                    std::uint32_t slot = allocate(signature.params[i]);
+                    store({"%p" + std::to_string(i), signature.params[i]}, slot);
+                    bindings.declare(node.formals->formals[i]->id->value, {slot, signature.params[i]}, true);
+                }
+                put(") {\nentry:\n");
+
+                // The body shares the function's scope
+                for (auto &st: node.body->statements) {
+                    dispatch(*st);
+                }
+                if (open) {
+                    // Falling off the end of a function that returns a value returns 0
+                    if (returnType == BuiltInType::VOID) {
+                        terminate("ret void");
+                    } else {
+                        terminate("ret ", typeName(returnType), ' ', zero(returnType));
+                    }
+                }
+                if (divides) {
+                    code += "divzero:\n  call void @hw3.divzero()\n  unreachable\n";
+                }
+                text += allocas;
+                text += code;
+                text += "}\n";
+            }
+
+            Value none() {
+                return {"", BuiltInType::VOID};
+            }
+
+            Value value(ast::Exp &exp) {
+                return dispatch(exp);
+            }
+
+            // v as type, which it is or which it widens to: only bytes widen, to ints
+            Value convert(const Value &v, BuiltInType type) {
+                if (v.type == BuiltInType::BYTE && type == BuiltInType::INT) {
+                    std::string result = temp();
+                    line(result, " = zext i8 ", v.text, " to i32");
+                    return {result, type};
+                }
+                return v;
+            }
+
+            std::uint32_t allocate(BuiltInType type) {
+                std::uint32_t slot = slots++;
+                allocas += "  %v";
+                append(allocas, slot);
+                allocas += " = alloca ";
+                allocas += typeName(type);
+                allocas += '\n';
+                return slot;
+            }
+
+            void store(const Value &v, std::uint32_t slot) {
+                line("store ", typeName(v.type), ' ', v.text, ", ptr %v", slot);
+            }
+
+            // A condition used as a value is written as branches too, and a phi picks true or false
+            Value boolean(ast::Exp &exp) {
+                std::string yes = label();
+                std::string no = label();
+                std::string end = label();
+                branch(exp, yes, no);
+                place(yes);
+                jump(end);
+                place(no);
+                jump(end);
+                place(end);
+                std::string result = temp();
+                line(result, " = phi i1 [ true, %", yes, " ], [ false, %", no, " ]");
+                return {result, BuiltInType::BOOL};
+            }
+
+            // Branches to yes when the condition exp holds and to no otherwise. The right operand of and and or is
+            // only evaluated when the left one does not decide
+            void branch(ast::Exp &exp, const std::string &yes, const std::string &no) {
+                switch (exp.kind) {
+                    case ast::NodeKind::Bool:
+                        jump(static_cast<ast::Bool &>(exp).value ? yes : no);
+                        break;
+                    case ast::NodeKind::Not:
+                        branch(*static_cast<ast::Not &>(exp).exp, no, yes);
+                        break;
+                    case ast::NodeKind::And: {
+                        auto &node = static_cast<ast::And &>(exp);
+                        std::string right = label();
+                        branch(*node.left, right, no);
+                        place(right);
+                        branch(*node.right, yes, no);
+                        break;
+                    }
+                    case ast::NodeKind::Or: {
+                        auto &node = static_cast<ast::Or &>(exp);
+                        std::string right = label();
+                        branch(*node.left, yes, right);
+                        place(right);
+                        branch(*node.right, yes, no);
+                        break;
+                    }
+                    default: {
+                        Value condition = value(exp);
+                        terminate("br i1 ", condition.text, ", label %", yes, ", label %", no);
+                        break;
+                    }
+                }
+            }
+
+            // The statement under an if, an else or a while has a scope of its own, as SemanticParser gives it
+            void nested(ast::Statement &st) {
+                Scope scope(bindings);
+                dispatch(st);
+            }
+
+            std::string temp() {
+                return "%t" + std::to_string(temps++);
+            }
+
+            std::string label() {
+                return "L" + std::to_string(labels++);
+            }
+
+            // Writes one instruction from its pieces. Code after a terminator, which nothing reaches, starts a
+            // block of its own
+            template<typename... Pieces>
+            void line(const Pieces &... pieces) {
+                if (!open) {
+                    code += label();
+                    code += ":\n";
+                    open = true;
+                }
+                code += "  ";
+                (append(code, pieces), ...);
+                code += '\n';
+            }
+
+            template<typename... Pieces>
+            void terminate(const Pieces &... pieces) {
+                line(pieces...);
+                open = false;
+            }
+
+            // Ends the current block with a branch to target, unless it has ended already
+            void jump(const std::string &target) {
+                if (open) {
+                    terminate("br label %", target);
+                }
+            }
+
+            // Starts the block target, which the current one falls through to
+            void place(const std::string &target) {
+                jump(target);
+                code += target;
+                code += ":\n";
+                open = true;
+            }
+
+            // A string constant as puts prints it, ending with a NUL
+            void constant(std::size_t index, const std::string &value) {
+                put("@.str.", index, " = private unnamed_addr constant [", value.size() + 1, " x i8] c\"");
+                for (char c: value) {
+                    auto byte = static_cast<unsigned char>(c);
+                    if (c == '"' || c == '\\' || byte < 0x20 || byte >= 0x7f) {
+                        char escaped[4];
+                        std::snprintf(escaped, sizeof(escaped), "\\%02X", byte);
+                        text += escaped;
+                    } else {
+                        text += c;
+                    }
+                }
+                text += "\\00\"\n";
+            }
+        };
+    }
+
+    void emit(ast::Funcs &funcs, const ast::Interner &names, std::ostream &os) {
+        Codegen(names, os).module(funcs);
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef LLVM_IR_HPP
+#define LLVM_IR_HPP
+
+#include <ostream>
+
+#include "nodes.hpp"
+
+/* LLVM IR for FanC programs, written by --emit-llvm
+ * A visitor over the checked tree, as SemanticParser is, writes the program as a textual LLVM module (.ll) for
+ * clang or opt and llc to optimize and compile. It is written the way clang writes C at -O0, leaving the optimizing
+ * to LLVM: every parameter and local is an alloca in its function's entry block, which mem2reg promotes to SSA
+ * registers, and conditions are branches, so and and or short-circuit. Types map to i32 (int), i8 (byte) and i1
+ * (bool); arithmetic wraps, bytes as i8 and ints at 32 bits. A division checks its divisor first: zero prints
+ * "Error division by zero" and exits, and INT_MIN / -1 wraps rather than overflowing. Strings are private global
+ * constants, printed with puts, and printi uses printf, so the program links against the C library:
+ *     hw3 --emit-llvm < prog.in > prog.ll && clang -O2 prog.ll -o prog
+ * Pointers are opaque (ptr), the default since LLVM 15; LLVM 14 tools need -opaque-pointers.
+ */
+namespace llvm_ir {
+    // Writes a program that SemanticParser has checked without errors to os as an LLVM module
+    void emit(ast::Funcs &funcs, const ast::Interner &names, std::ostream &os);
+}
+
+#endif //LLVM_IR_HPP
@@ -1,85 +1,122 @@
 #include "SemanticParser.hpp"
-#include <iostream>
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <thread>
 
 using ast::BuiltInType;
 
+// Below this many functions per thread, starting threads costs more than it saves
+static constexpr std::size_t MIN_FUNCS_PER_THREAD = 64;
+
 void SemanticParser::print() const {
-    std::cout << printer;
+    if (stream) {
+        stream->scopes.print(output::Destination::stream(), printer);
+        return;
+    }
+    output::Destination::stream() << printer;
 }
 
-SemanticParser::SemanticParser() {
-    // global scope exists as a map, but we don't printer.beginScope() for global.
+SemanticParser::SemanticParser(ast::Interner& names, unsigned jobs) : names(names), jobs(jobs), printer(names) {
+    // global scope is the symbol table's bottom scope, but we don't printer.beginScope() for global.
     // operator<< already prints ---begin global scope--- and uses globalsBuffer for funcs.
-    scopes.push_back({});
-    insertFunc("print",  BuiltInType::VOID, {BuiltInType::STRING}, 0);
-    insertFunc("printi", BuiltInType::VOID, {BuiltInType::INT},    0);
+    // The built-in functions are counted as declared should countSymbols() be called later
+    symbols.countInto(&symbolCounts);
+    insertFunc(names.intern("print"),  BuiltInType::VOID, {BuiltInType::STRING}, 0);
+    insertFunc(names.intern("printi"), BuiltInType::VOID, {BuiltInType::INT},    0);
+    symbols.countInto(nullptr);
 }
 
+SemanticParser::SemanticParser(ast::Interner& names, const SymbolTable& globals)
+        : names(names), jobs(1), symbols(&globals), printer(names) {}
+
 void SemanticParser::pushScope() {
-    scopes.push_back({});
+    symbols.pushScope();
     printer.beginScope();
     scopeOffsetStack.push_back(nextLocalOffset);
+    if (trace::recording()) {
+        scopeStarts.push_back(trace::now());
+    }
 }
 
 void SemanticParser::popScope() {
     printer.endScope();
-    scopes.pop_back();
+    symbols.popScope();
     if (!scopeOffsetStack.empty()) {
         nextLocalOffset = scopeOffsetStack.back();
         scopeOffsetStack.pop_back();
     }
-}
-
-bool SemanticParser::existsInAnyScope(const std::string& name) const {
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        if (it->find(name) != it->end()) return true;
+    if (!scopeStarts.empty()) {
+        trace::scope(scopeStarts.back(), tracedFunction);
+        scopeStarts.pop_back();
     }
-    return false;
 }
 
-SymbolEntry* SemanticParser::lookup(const std::string& name) {
-    for (auto it = scopes.rbegin(); it != scopes.rend(); ++it) {
-        auto f = it->find(name);
-        if (f != it->end()) return &f->second;
+const SymbolEntry* SemanticParser::lookup(ast::SymbolId name) {
+    const SymbolEntry* e = symbols.lookup(name);
+    if (!e) {
+        assumeNotFunction(name);
     }
-    return nullptr;
+    return e;
 }
 
-bool SemanticParser::existsInCurrentScope(const std::string& name) const {
-    return scopes.back().find(name) != scopes.back().end();
+bool SemanticParser::existsInCurrentScope(ast::SymbolId name) const {
+    return symbols.existsInCurrentScope(name);
 }
 
-void SemanticParser::insertVar(const std::string& name, BuiltInType type, int offset, int lineno) {
-    if (existsInAnyScope(name)) {
+void SemanticParser::insertVar(ast::SymbolId name, BuiltInType type, int offset, int lineno) {
+    SymbolEntry* e = symbols.declare(name);
+    if (!e) {
         output::errorDef(lineno, name);
     }
+    assumeNotFunction(name);
 
-    SymbolEntry e;
-    e.name = name;
-    e.isFunc = false;
-    e.type = type;
-    e.offset = offset;
+    e->isFunc = false;
+    e->type = type;
+    e->offset = offset;
 
-    scopes.back()[name] = e;
     printer.emitVar(name, type, offset);
 }
 
-void SemanticParser::insertFunc(const std::string& name, BuiltInType ret,
+void SemanticParser::insertFunc(ast::SymbolId name, BuiltInType ret,
                                const std::vector<BuiltInType>& params,
                                int lineno) {
-    if (scopes.front().find(name) != scopes.front().end()) {
+    // Functions are only declared while the global scope is the only open scope
+    SymbolEntry* e = symbols.declare(name);
+    if (!e) {
         output::errorDef(lineno, name);
     }
-    SymbolEntry e;
-    e.name = name;
-    e.isFunc = true;
-    e.type = ret;
-    e.paramTypes = params;
+    e->isFunc = true;
+    e->type = ret;
+    e->paramTypes = params;
 
-    scopes.front()[name] = e; // force into global
     printer.emitFunc(name, ret, params);
 }
 
+void SemanticParser::declarePrototype(const ast::FuncDecl& f) {
+    std::vector<BuiltInType> params;
+    for (auto &p : f.formals->formals) {
+        params.push_back(p->type->type);
+    }
+    insertFunc(f.id->value, f.return_type->type, params, f.id->line);
+}
+
+void SemanticParser::assumeNotFunction(ast::SymbolId name) {
+    if (!stream || stream->finishing) {
+        return;
+    }
+    auto& first = stream->firstAssumer;
+    if (name >= first.size()) {
+        first.resize(std::max<std::size_t>(name + 1, 2 * first.size()), Stream::NONE);
+    }
+    if (first[name] == Stream::NONE) {
+        first[name] = static_cast<std::uint32_t>(stream->count - 1);
+    }
+}
+
 bool SemanticParser::isNumeric(BuiltInType t) {
     return t == BuiltInType::INT || t == BuiltInType::BYTE;
 }
@@ -102,9 +139,11 @@ BuiltInType SemanticParser::widenNumeric(BuiltInType a, BuiltInType b) {
     return BuiltInType::BYTE; // both byte
 }
 
-void SemanticParser::ensureMainExists(const ast::Funcs& root) {
+void SemanticParser::ensureMainExists() {
     // must have: void main()  (no params)
-    auto* e = lookup("main");
+    // "main" is only interned if some identifier spelled it
+    auto mainName = names.find("main");
+    auto* e = mainName ? lookup(*mainName) : nullptr;
     if (!e || !e->isFunc) {
         output::errorMainMissing();
     }
@@ -118,29 +157,272 @@ void SemanticParser::ensureMainExists(const ast::Funcs& root) {
 
 // -------------------- Visitors --------------------
 
-void SemanticParser::visit(ast::Funcs &node) {
-    // PASS 1: declare prototypes in global scope
-    for (auto &f : node.funcs) {
-        auto fname = f->id->value;
+BuiltInType SemanticParser::visit(ast::Funcs &node) {
+    {
+        Stats::Timer timer(stats, Stats::PASS1);
+        trace::Span span("pass 1");
+        // PASS 1: declare prototypes in global scope
+        for (auto &f : node.funcs) {
+            declarePrototype(*f);
+        }
+
+        // main check (after prototypes exist)
+        ensureMainExists();
+    }
+
+    // PASS 2: analyze each function body
+    Stats::Timer timer(stats, Stats::PASS2);
+    trace::Span span("pass 2");
+    analyzeBodies(node);
+    return BuiltInType::VOID;
+}
+
+void SemanticParser::analyzeBodies(ast::Funcs& root) {
+    if (lazyBodies) {
+        for (std::size_t i = 0; i < root.funcs.size(); ++i) {
+            ast::FuncDecl& f = *root.funcs[i];
+            std::optional<AnalysisCache::Key> key;
+            if (cache) {
+                std::string scopes;
+                key = cacheKey(f, lazyBodies->text(i));
+                if (key && cache->load(*key, scopes)) {
+                    printer.appendRendered(std::move(scopes));
+                    continue;
+                }
+            }
 
-        std::vector<BuiltInType> params;
-        for (auto &p : f->formals->formals) {
-            params.push_back(p->type->type);
+            f.body = lazyBodies->parse(i);
+            if (stats) {
+                stats->countNodes(*f.body);
+            }
+            if (key) {
+                // Record the function's scopes on their own, to store them; an error ends the analysis anyway
+                output::ScopePrinter fragment(names);
+                std::swap(printer, fragment);
+                visit(f);
+                std::swap(printer, fragment);
+
+                output::OutputBuffer rendered;
+                fragment.renderScopes(rendered);
+                std::ostringstream scopes;
+                rendered.writeTo(scopes);
+                cache->store(*key, scopes.str());
+                printer.append(fragment);
+            } else {
+                visit(f);
+            }
+            f.body = nullptr;
+            lazyBodies->release(i);
         }
-        BuiltInType ret = f->return_type->type;
-        insertFunc(fname, ret, params, f->id->line);
+        return;
     }
 
-    // main check (after prototypes exist)
-    ensureMainExists(node);
+    const std::size_t count = root.funcs.size();
+    std::size_t threads = jobs ? jobs : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, std::max<std::size_t>(1, count / MIN_FUNCS_PER_THREAD));
 
-    // PASS 2: analyze each function body
-    for (auto &f : node.funcs) {
-        f->accept(*this);
+    if (threads == 1) {
+        for (auto &f : root.funcs) {
+            visit(*f);
+        }
+        return;
+    }
+
+    // Bodies only read the global scope, which is complete after pass 1. Each thread analyzes the functions it
+    // takes with its own analyzer and records every function's scopes separately; the fragments are appended in
+    // source order afterwards, so the output does not depend on scheduling.
+    std::vector<output::ScopePrinter> fragments(count, output::ScopePrinter(names));
+
+    // Serially, the first function with an error ends the analysis, so only the earliest failure is reported
+    struct Failure {
+        std::size_t index;
+        std::string message;
+        std::exception_ptr exception;
+    };
+    std::vector<Failure> failures(threads, Failure{count, {}, nullptr});
+    std::atomic<std::size_t> next(0);
+    std::atomic<std::size_t> firstFailure(count);
+
+    auto work = [&](std::size_t t) {
+        SemanticParser worker(names, symbols);
+        if (stats) {
+            worker.countSymbols();
+        }
+        std::ostringstream message;
+        output::Destination destination(message, &names);
+
+        for (std::size_t i = next++; i < count && i < firstFailure; i = next++) {
+            try {
+                worker.printer = output::ScopePrinter(names);
+                worker.visit(*root.funcs[i]);
+                fragments[i] = std::move(worker.printer);
+            } catch (const output::Aborted &) {
+                failures[t] = {i, message.str(), nullptr};
+            } catch (...) {
+                failures[t] = {i, {}, std::current_exception()};
+            }
+            if (failures[t].index == i) {
+                // Functions after this one no longer matter; the analyzer's scopes are left open, so stop here
+                std::size_t seen = firstFailure;
+                while (i < seen && !firstFailure.compare_exchange_weak(seen, i)) {
+                }
+                break;
+            }
+        }
+        if (stats) {
+            stats->addSymbols(worker.symbolCounters());
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto &thread : pool) {
+        thread.join();
     }
+
+    auto first = std::min_element(failures.begin(), failures.end(),
+                                  [](const Failure &a, const Failure &b) { return a.index < b.index; });
+    if (first->index < count) {
+        if (first->exception) {
+            std::rethrow_exception(first->exception);
+        }
+        output::Destination::stream() << first->message;
+        throw output::Aborted();
+    }
+
+    for (const auto &fragment : fragments) {
+        printer.append(fragment);
+    }
+}
+
+std::optional<AnalysisCache::Key> SemanticParser::cacheKey(const ast::FuncDecl& f, std::string_view body) const {
+    AnalysisCache::Hasher hasher;
+    hasher.add(static_cast<std::uint64_t>(f.return_type->type));
+    hasher.add(f.formals->formals.size());
+
+    // Only the global scope, which holds the prototypes, is open, and a name no identifier spelled is not in it
+    auto global = [&](std::string_view name) {
+        auto id = names.find(name);
+        const SymbolEntry* e = id ? symbols.lookup(*id) : nullptr;
+        if (!e) {
+            hasher.add(std::uint64_t{0});
+            return;
+        }
+        hasher.add(1 + static_cast<std::uint64_t>(e->type));
+        hasher.add(e->paramTypes.size());
+        for (BuiltInType t : e->paramTypes) {
+            hasher.add(static_cast<std::uint64_t>(t));
+        }
+    };
+    for (auto &p : f.formals->formals) {
+        hasher.add(static_cast<std::uint64_t>(p->type->type));
+        hasher.add(names.name(p->id->value));
+        // A parameter named like a function is an error
+        global(names.name(p->id->value));
+    }
+
+    bool clean = AnalysisCache::hashTokens(body, hasher, global);
+    if (!clean) {
+        return std::nullopt;
+    }
+    return hasher.key();
 }
 
-void SemanticParser::visit(ast::FuncDecl &node) {
+void SemanticParser::streamFunction(ast::FuncDecl& decl) {
+    if (!stream) {
+        stream = std::make_unique<Stream>();
+    }
+    const std::size_t index = stream->count++;
+    stream->failed.push_back(false);
+    if (stream->duplicate) {
+        return;
+    }
+
+    // Errors are only reported by finishStream, which knows whether they stand
+    std::ostream discard(nullptr);
+    output::Destination quiet(discard, &names);
+
+    try {
+        declarePrototype(decl);
+    } catch (const output::Aborted &) {
+        stream->duplicate = {decl.id->line, decl.id->value};
+        return;
+    }
+
+    // Bodies that relied on this name not being a function were analyzed wrongly
+    auto& first = stream->firstAssumer;
+    ast::SymbolId name = decl.id->value;
+    if (name < first.size() && first[name] != Stream::NONE) {
+        std::size_t from = first[name];
+        first[name] = Stream::NONE;
+        auto& stale = stream->stale;
+        while (!stale.empty() && stale.back().second >= from) {
+            from = std::min(from, stale.back().first);
+            stale.pop_back();
+        }
+        stale.emplace_back(from, index);
+    }
+
+    try {
+        analyzeStreamed(decl, index);
+    } catch (const output::Aborted &) {
+        stream->failed[index] = true;
+    }
+}
+
+void SemanticParser::finishStream(StreamedFunctions& functions) {
+    if (!stream) {
+        stream = std::make_unique<Stream>();
+    }
+    stream->finishing = true;
+
+    // In the order of a full analysis: pass 1, the main check, then the first body that fails
+    if (stream->duplicate) {
+        output::errorDef(stream->duplicate->first, stream->duplicate->second);
+    }
+    ensureMainExists();
+
+    auto stale = stream->stale.begin();
+    for (std::size_t i = 0; i < stream->count; ++i) {
+        while (stale != stream->stale.end() && stale->second <= i) {
+            ++stale;
+        }
+        bool isStale = stale != stream->stale.end() && stale->first <= i;
+        if (!isStale && !stream->failed[i]) {
+            continue;
+        }
+        analyzeStreamed(*functions.parse(i), i);
+        functions.release(i);
+    }
+}
+
+void SemanticParser::analyzeStreamed(ast::FuncDecl& f, std::size_t index) {
+    output::ScopePrinter fragment(names);
+    std::swap(printer, fragment);
+    try {
+        visit(f);
+    } catch (const output::Aborted &) {
+        std::swap(printer, fragment);
+        while (symbols.depth() > 1) {
+            symbols.popScope();
+        }
+        scopeOffsetStack.clear();
+        scopeStarts.clear();
+        whileDepth = 0;
+        statementsAlreadyScoped = false;
+        insideFunction = false;
+        throw;
+    }
+    std::swap(printer, fragment);
+    stream->scopes.put(index, fragment);
+}
+
+BuiltInType SemanticParser::visit(ast::FuncDecl &node) {
+    tracedFunction = trace::recording() ? names.name(node.id->value) : std::string_view();
+    trace::Span span("analyze", tracedFunction, node.line);
     insideFunction = true;
     currentFuncReturn = node.return_type->type;
 
@@ -153,7 +435,7 @@ void SemanticParser::visit(ast::FuncDecl &node) {
 
     // Insert parameters into function scope with negative offsets
     for (auto &p : node.formals->formals) {
-        const std::string& pname = p->id->value;
+        ast::SymbolId pname = p->id->value;
         BuiltInType ptype = p->type->type;
         insertVar(pname, ptype, nextParamOffset, p->line);
         nextParamOffset--;
@@ -163,7 +445,7 @@ void SemanticParser::visit(ast::FuncDecl &node) {
     // Prevent "extra scope" wrapping for this body Statements node:
     bool prev = statementsAlreadyScoped;
     statementsAlreadyScoped = true;
-    node.body->accept(*this);
+    visit(*node.body);
     statementsAlreadyScoped = prev;
 
     // Leave function scope
@@ -171,19 +453,22 @@ void SemanticParser::visit(ast::FuncDecl &node) {
 
     insideFunction = false;
     currentFuncReturn = BuiltInType::VOID;
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Formals &node) {
+BuiltInType SemanticParser::visit(ast::Formals &node) {
     // not used directly for semantics in this design (handled in FuncDecl)
     (void)node;
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Formal &node) {
+BuiltInType SemanticParser::visit(ast::Formal &node) {
     // not used directly for semantics in this design (handled in FuncDecl)
     (void)node;
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Statements &node) {
+BuiltInType SemanticParser::visit(ast::Statements &node) {
     // If this Statements is a "block statement" we normally want scope,
     // BUT for function body we already pushed scope; we avoid double-scope using flag.
     if (!statementsAlreadyScoped) {
@@ -197,17 +482,17 @@ void SemanticParser::visit(ast::Statements &node) {
     if (!statementsAlreadyScoped) {
         popScope();
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visitStatementPossiblyBlock(const std::shared_ptr<ast::Statement>& st,
+void SemanticParser::visitStatementPossiblyBlock(ast::Statement* st,
                                                  bool forceScopeForSingleStmt) {
-    auto asBlock = std::dynamic_pointer_cast<ast::Statements>(st);
-    if (asBlock) {
+    if (st->kind == ast::NodeKind::Statements) {
         // A real block: it should introduce exactly ONE scope (handled here)
         pushScope();
         bool prev = statementsAlreadyScoped;
         statementsAlreadyScoped = true;
-        asBlock->accept(*this);
+        visit(static_cast<ast::Statements&>(*st));
         statementsAlreadyScoped = prev;
         popScope();
         return;
@@ -215,32 +500,32 @@ void SemanticParser::visitStatementPossiblyBlock(const std::shared_ptr<ast::Stat
 
     if (forceScopeForSingleStmt) {
         pushScope();
-        st->accept(*this);
+        dispatch(*st);
         popScope();
     } else {
-        st->accept(*this);
+        dispatch(*st);
     }
 }
 
 
-void SemanticParser::visit(ast::VarDecl &node) {
+BuiltInType SemanticParser::visit(ast::VarDecl &node) {
     BuiltInType t = node.type->type;
-    const std::string& name = node.id->value;
+    ast::SymbolId name = node.id->value;
 
     // insert first (so init can refer? depends on spec; usually init can refer to earlier vars, not itself)
     int off = nextLocalOffset++;
     insertVar(name, t, off, node.id->line);
 
     if (node.init_exp) {
-        node.init_exp->accept(*this);
-        BuiltInType initT = lastType;
+        BuiltInType initT = dispatch(*node.init_exp);
         if (!canAssign(t, initT)) {
             output::errorMismatch(node.line);
         }
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Assign &node) {
+BuiltInType SemanticParser::visit(ast::Assign &node) {
     // left must be var
     auto* e = lookup(node.id->value);
     if (!e) {
@@ -250,15 +535,15 @@ void SemanticParser::visit(ast::Assign &node) {
         output::errorDefAsFunc(node.line, node.id->value);
     }
 
-    node.exp->accept(*this);
-    BuiltInType rhs = lastType;
+    BuiltInType rhs = dispatch(*node.exp);
 
     if (!canAssign(e->type, rhs)) {
         output::errorMismatch(node.line);
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::ID &node) {
+BuiltInType SemanticParser::visit(ast::ID &node) {
     auto* e = lookup(node.value);
     if (!e) {
         output::errorUndef(node.line, node.value);
@@ -266,10 +551,10 @@ void SemanticParser::visit(ast::ID &node) {
     if (e->isFunc) {
         output::errorDefAsFunc(node.line, node.value);
     }
-    lastType = e->type;
+    return e->type;
 }
 
-void SemanticParser::visit(ast::Call &node) {
+BuiltInType SemanticParser::visit(ast::Call &node) {
     auto* e = lookup(node.func_id->value);
     if (!e) {
         output::errorUndefFunc(node.line, node.func_id->value);
@@ -281,8 +566,7 @@ void SemanticParser::visit(ast::Call &node) {
     // collect actual arg types
     std::vector<BuiltInType> actuals;
     for (auto &a : node.args->exps) {
-        a->accept(*this);
-        actuals.push_back(lastType);
+        actuals.push_back(dispatch(*a));
     }
 
     // arity check
@@ -322,10 +606,10 @@ void SemanticParser::visit(ast::Call &node) {
     }
 
     // call expression type is function return type
-    lastType = e->type;
+    return e->type;
 }
 
-void SemanticParser::visit(ast::Return &node) {
+BuiltInType SemanticParser::visit(ast::Return &node) {
     if (!insideFunction) {
         // shouldn't happen in valid parse tree, but keep safe
         output::errorMismatch(node.line);
@@ -335,20 +619,19 @@ void SemanticParser::visit(ast::Return &node) {
         if (currentFuncReturn != BuiltInType::VOID) {
             output::errorMismatch(node.line);
         }
-        return;
+        return BuiltInType::VOID;
     }
 
-    node.exp->accept(*this);
-    BuiltInType rt = lastType;
+    BuiltInType rt = dispatch(*node.exp);
 
     if (!canAssign(currentFuncReturn, rt)) {
         output::errorMismatch(node.line);
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::If &node) {
-    node.condition->accept(*this);
-    if (lastType != BuiltInType::BOOL) {
+BuiltInType SemanticParser::visit(ast::If &node) {
+    if (dispatch(*node.condition) != BuiltInType::BOOL) {
         output::errorMismatch(node.condition->line);
     }
 
@@ -361,11 +644,11 @@ void SemanticParser::visit(ast::If &node) {
         visitStatementPossiblyBlock(node.otherwise, false);
         popScope();
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::While &node) {
-    node.condition->accept(*this);
-    if (lastType != BuiltInType::BOOL) {
+BuiltInType SemanticParser::visit(ast::While &node) {
+    if (dispatch(*node.condition) != BuiltInType::BOOL) {
         output::errorMismatch(node.condition->line);
     }
 
@@ -374,124 +657,117 @@ void SemanticParser::visit(ast::While &node) {
     visitStatementPossiblyBlock(node.body, false);
     whileDepth--;
     popScope();
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Break &node) {
+BuiltInType SemanticParser::visit(ast::Break &node) {
     if (whileDepth <= 0) {
         output::errorUnexpectedBreak(node.line);
     }
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Continue &node) {
+BuiltInType SemanticParser::visit(ast::Continue &node) {
     if (whileDepth <= 0) {
         output::errorUnexpectedContinue(node.line);
     }
+    return BuiltInType::VOID;
 }
 
 // ----------------- Expressions -----------------
 
-void SemanticParser::visit(ast::Num &node) {
+BuiltInType SemanticParser::visit(ast::Num &node) {
     (void)node;
-    lastType = BuiltInType::INT;
+    return BuiltInType::INT;
 }
 
-void SemanticParser::visit(ast::NumB &node) {
+BuiltInType SemanticParser::visit(ast::NumB &node) {
     if (node.value < 0 || node.value > 255) {
         output::errorByteTooLarge(node.line, node.value);
     }
-    lastType = BuiltInType::BYTE;
+    return BuiltInType::BYTE;
 }
 
-void SemanticParser::visit(ast::String &node) {
+BuiltInType SemanticParser::visit(ast::String &node) {
     (void)node;
-    lastType = BuiltInType::STRING;
+    return BuiltInType::STRING;
 }
 
-void SemanticParser::visit(ast::Bool &node) {
+BuiltInType SemanticParser::visit(ast::Bool &node) {
     (void)node;
-    lastType = BuiltInType::BOOL;
+    return BuiltInType::BOOL;
 }
 
-void SemanticParser::visit(ast::BinOp &node) {
-    node.left->accept(*this);
-    BuiltInType l = lastType;
-    node.right->accept(*this);
-    BuiltInType r = lastType;
+BuiltInType SemanticParser::visit(ast::BinOp &node) {
+    BuiltInType l = dispatch(*node.left);
+    BuiltInType r = dispatch(*node.right);
 
     if (!isNumeric(l) || !isNumeric(r)) {
         output::errorMismatch(node.line);
     }
 
     // division usually forces INT (depending on spec); here we widen normally
-    lastType = widenNumeric(l, r);
+    return widenNumeric(l, r);
 }
 
-void SemanticParser::visit(ast::RelOp &node) {
-    node.left->accept(*this);
-    BuiltInType l = lastType;
-    node.right->accept(*this);
-    BuiltInType r = lastType;
+BuiltInType SemanticParser::visit(ast::RelOp &node) {
+    BuiltInType l = dispatch(*node.left);
+    BuiltInType r = dispatch(*node.right);
 
     if (isNumeric(l) && isNumeric(r)) {
-        lastType = BuiltInType::BOOL;
-        return;
+        return BuiltInType::BOOL;
     }
 
     output::errorMismatch(node.line);
 }
 
-void SemanticParser::visit(ast::Not &node) {
-    node.exp->accept(*this);
-    if (lastType != BuiltInType::BOOL) {
+BuiltInType SemanticParser::visit(ast::Not &node) {
+    if (dispatch(*node.exp) != BuiltInType::BOOL) {
         output::errorMismatch(node.line);
     }
-    lastType = BuiltInType::BOOL;
+    return BuiltInType::BOOL;
 }
 
-void SemanticParser::visit(ast::And &node) {
-    node.left->accept(*this);
-    BuiltInType l = lastType;
-    node.right->accept(*this);
-    BuiltInType r = lastType;
+BuiltInType SemanticParser::visit(ast::And &node) {
+    BuiltInType l = dispatch(*node.left);
+    BuiltInType r = dispatch(*node.right);
 
     if (l != BuiltInType::BOOL || r != BuiltInType::BOOL) {
         output::errorMismatch(node.line);
     }
-    lastType = BuiltInType::BOOL;
+    return BuiltInType::BOOL;
 }
 
-void SemanticParser::visit(ast::Or &node) {
-    node.left->accept(*this);
-    BuiltInType l = lastType;
-    node.right->accept(*this);
-    BuiltInType r = lastType;
+BuiltInType SemanticParser::visit(ast::Or &node) {
+    BuiltInType l = dispatch(*node.left);
+    BuiltInType r = dispatch(*node.right);
 
     if (l != BuiltInType::BOOL || r != BuiltInType::BOOL) {
         output::errorMismatch(node.line);
     }
-    lastType = BuiltInType::BOOL;
+    return BuiltInType::BOOL;
 }
 
-void SemanticParser::visit(ast::Type &node) {
+BuiltInType SemanticParser::visit(ast::Type &node) {
     // Not an expression; usually no-op
     (void)node;
+    return BuiltInType::VOID;
 }
 
-void SemanticParser::visit(ast::Cast &node) {
-    node.exp->accept(*this);
-    BuiltInType src = lastType;
+BuiltInType SemanticParser::visit(ast::Cast &node) {
+    BuiltInType src = dispatch(*node.exp);
     BuiltInType dst = node.target_type->type;
 
     // Typical rule: only numeric casts between byte/int allowed
     if (isNumeric(src) && isNumeric(dst)) {
-        lastType = dst;
-        return;
+        return dst;
     }
 
     output::errorMismatch(node.line);
 }
 
-void SemanticParser::visit(ast::ExpList &node) {
+BuiltInType SemanticParser::visit(ast::ExpList &node) {
     // Not used directly (Call iterates args)
     (void)node;
+    return BuiltInType::VOID;
 }
@@ -1,68 +1,151 @@
 #ifndef SEMANTICPARSER_HPP
 #define SEMANTICPARSER_HPP
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include <optional>
+#include <string_view>
+#include <utility>
 
-#include "visitor.hpp"
+#include "AnalysisCache.hpp"
+#include "static_visitor.hpp"
 #include "nodes.hpp"
 #include "output.hpp"
+#include "Stats.hpp"
+#include "SymbolTable.hpp"
 
-struct SymbolEntry {
-    std::string name;
-    bool isFunc = false;
+/* Function bodies that are parsed only when pass 2 reaches them (see parseHeaders) */
+class LazyBodies {
+public:
+    virtual ~LazyBodies() = default;
+
+    // Parses the body of the index-th function; errors are reported through output and throw output::Aborted
+    virtual ast::Statements* parse(std::size_t index) = 0;
+
+    // Drops the body parse(index) returned, once it has been analyzed
+    virtual void release(std::size_t index) = 0;
+
+    // Text of the body of the index-th function, from after its { up to and including its }
+    virtual std::string_view text(std::size_t index) = 0;
+};
 
-    // For vars: var type
-    // For funcs: return type
-    ast::BuiltInType type = ast::BuiltInType::VOID;
+/* Functions analyzed as they were parsed (see streamFunction), parsed again when finishStream needs one */
+class StreamedFunctions {
+public:
+    virtual ~StreamedFunctions() = default;
 
-    // Only for funcs
-    std::vector<ast::BuiltInType> paramTypes;
+    // Parses the index-th function again; it parsed without error the first time
+    virtual ast::FuncDecl* parse(std::size_t index) = 0;
 
-    // Only for vars/params
-    int offset = 0;
+    // Drops the function parse(index) returned, once it has been analyzed
+    virtual void release(std::size_t index) = 0;
 };
 
-class SemanticParser : public Visitor {
+// Every visit returns the type of the visited node: the expression's type, or VOID for statements and declarations
+class SemanticParser : public StaticVisitor<SemanticParser, ast::BuiltInType> {
 public:
-    SemanticParser();
+    // Identifiers are resolved against names, which must be the interner the scanner used.
+    // Function bodies are analyzed on up to jobs threads; 0 means one per hardware thread
+    explicit SemanticParser(ast::Interner& names, unsigned jobs = 1);
+
+    // Takes function bodies, which the tree does not have, from bodies. Pass 2 then analyzes one function at a time,
+    // so that only one body is in memory
+    void setLazyBodies(LazyBodies* bodies) { lazyBodies = bodies; }
+
+    // With lazy bodies, takes the scopes of bodies whose analysis is in cache from there instead of parsing and
+    // analyzing them, and stores those of the bodies it does analyze
+    void setCache(const AnalysisCache* cache) { this->cache = cache; }
+
+    // Times the passes into stats, counts the symbol tables of parallel pass 2 into it, and counts the nodes of the
+    // bodies parsed on demand. The analyzer's own table is left to the caller, through countSymbols()
+    void setStats(Stats* stats) { this->stats = stats; }
+
+    // Counts the work of the analyzer's own symbol table from now on, for symbolCounters()
+    void countSymbols() { symbols.countInto(&symbolCounts); }
+
+    const SymbolTable::Counters& symbolCounters() const { return symbolCounts; }
+
+    // Streaming analysis, for a program that is never in memory as a whole. streamFunction declares the prototype of
+    // each function as soon as it is parsed and analyzes its body right away, against the prototypes declared so
+    // far; nothing is printed, and all that is kept of the function is its scopes, in a temporary file.
+    void streamFunction(ast::FuncDecl& decl);
+    // Once the last function is streamed, reports the error a full analysis would. Bodies that looked up or declared
+    // a name that a later function turned out to have are analyzed again, taken from functions, and so is the first
+    // body that failed, for its message. print() then writes the scopes
+    void finishStream(StreamedFunctions& functions);
 
     // Let main() print scopes
     const output::ScopePrinter& getPrinter() const { return printer; }
+    // Writes the scopes to the current output destination
     void print() const;
-    // Visitor overrides
-    void visit(ast::Num &node) override;
-    void visit(ast::NumB &node) override;
-    void visit(ast::String &node) override;
-    void visit(ast::Bool &node) override;
-    void visit(ast::ID &node) override;
-    void visit(ast::BinOp &node) override;
-    void visit(ast::RelOp &node) override;
-    void visit(ast::Not &node) override;
-    void visit(ast::And &node) override;
-    void visit(ast::Or &node) override;
-    void visit(ast::Type &node) override;
-    void visit(ast::Cast &node) override;
-    void visit(ast::ExpList &node) override;
-    void visit(ast::Call &node) override;
-    void visit(ast::Statements &node) override;
-    void visit(ast::Break &node) override;
-    void visit(ast::Continue &node) override;
-    void visit(ast::Return &node) override;
-    void visit(ast::If &node) override;
-    void visit(ast::While &node) override;
-    void visit(ast::VarDecl &node) override;
-    void visit(ast::Assign &node) override;
-    void visit(ast::Formal &node) override;
-    void visit(ast::Formals &node) override;
-    void visit(ast::FuncDecl &node) override;
-    void visit(ast::Funcs &node) override;
+    // Visits, dispatched statically through StaticVisitor::dispatch
+    ast::BuiltInType visit(ast::Num &node);
+    ast::BuiltInType visit(ast::NumB &node);
+    ast::BuiltInType visit(ast::String &node);
+    ast::BuiltInType visit(ast::Bool &node);
+    ast::BuiltInType visit(ast::ID &node);
+    ast::BuiltInType visit(ast::BinOp &node);
+    ast::BuiltInType visit(ast::RelOp &node);
+    ast::BuiltInType visit(ast::Not &node);
+    ast::BuiltInType visit(ast::And &node);
+    ast::BuiltInType visit(ast::Or &node);
+    ast::BuiltInType visit(ast::Type &node);
+    ast::BuiltInType visit(ast::Cast &node);
+    ast::BuiltInType visit(ast::ExpList &node);
+    ast::BuiltInType visit(ast::Call &node);
+    ast::BuiltInType visit(ast::Statements &node);
+    ast::BuiltInType visit(ast::Break &node);
+    ast::BuiltInType visit(ast::Continue &node);
+    ast::BuiltInType visit(ast::Return &node);
+    ast::BuiltInType visit(ast::If &node);
+    ast::BuiltInType visit(ast::While &node);
+    ast::BuiltInType visit(ast::VarDecl &node);
+    ast::BuiltInType visit(ast::Assign &node);
+    ast::BuiltInType visit(ast::Formal &node);
+    ast::BuiltInType visit(ast::Formals &node);
+    ast::BuiltInType visit(ast::FuncDecl &node);
+    ast::BuiltInType visit(ast::Funcs &node);
 
 private:
+    // Analyzer for the bodies of functions whose prototypes are in globals, which it only reads
+    SemanticParser(ast::Interner& names, const SymbolTable& globals);
+
+    ast::Interner& names;
+
+    // Threads for pass 2
+    unsigned jobs;
+
+    LazyBodies* lazyBodies = nullptr;
+    const AnalysisCache* cache = nullptr;
+    Stats* stats = nullptr;
+
+    /* State of a streaming analysis */
+    struct Stream {
+        static constexpr std::uint32_t NONE = UINT32_MAX;
+
+        // Functions streamed so far
+        std::size_t count = 0;
+        // Whether the body of each function failed
+        std::vector<bool> failed;
+        // Line and name of the first function declared twice, which fails pass 1 whatever the bodies hold
+        std::optional<std::pair<int, ast::SymbolId>> duplicate;
+        // For each name that bodies looked up in vain or declared, the first function to do so (NONE if none)
+        std::vector<std::uint32_t> firstAssumer;
+        // Ranges [first, last) of functions whose bodies were analyzed without the prototype of a later function they
+        // use, disjoint and in order
+        std::vector<std::pair<std::size_t, std::size_t>> stale;
+        // Set by finishStream, when every prototype is known
+        bool finishing = false;
+        output::SpilledScopes scopes;
+    };
+
+    std::unique_ptr<Stream> stream;
+
     // ----- Scopes -----
-    std::vector<std::unordered_map<std::string, SymbolEntry>> scopes;
+    SymbolTable symbols;
+    SymbolTable::Counters symbolCounts;
 
     // Printing
     output::ScopePrinter printer;
@@ -80,8 +163,9 @@ private:
 
 	std::vector<int> scopeOffsetStack;
 
-    // Expression type "return channel"
-    ast::BuiltInType lastType = ast::BuiltInType::VOID;
+    // With --trace, when each open scope opened, and the function they are in
+    std::vector<std::uint64_t> scopeStarts;
+    std::string_view tracedFunction;
 
     // A flag to avoid double-scoping the same Statements node
     bool statementsAlreadyScoped = false;
@@ -91,14 +175,17 @@ private:
     void pushScope();
     void popScope();
 
-    bool existsInAnyScope(const std::string& name) const;
-    bool existsInCurrentScope(const std::string& name) const;
-    SymbolEntry* lookup(const std::string& name);
+    bool existsInCurrentScope(ast::SymbolId name) const;
+    const SymbolEntry* lookup(ast::SymbolId name);
 
-    void insertVar(const std::string& name, ast::BuiltInType type, int offset, int lineno);
-    void insertFunc(const std::string& name, ast::BuiltInType ret,
+    void insertVar(ast::SymbolId name, ast::BuiltInType type, int offset, int lineno);
+    void insertFunc(ast::SymbolId name, ast::BuiltInType ret,
                     const std::vector<ast::BuiltInType>& params,
                     int lineno);
+    // Pass 1 for one function
+    void declarePrototype(const ast::FuncDecl& f);
+    // Notes, when streaming, that the body being analyzed relies on name not being a function
+    void assumeNotFunction(ast::SymbolId name);
 
     // Type helpers
     static bool isNumeric(ast::BuiltInType t);
@@ -109,10 +196,21 @@ private:
     static ast::BuiltInType widenNumeric(ast::BuiltInType a, ast::BuiltInType b); // byte+int => int
 
     // Visit a statement that might be a block (Statements-as-Statement) and should open scope
-    void visitStatementPossiblyBlock(const std::shared_ptr<ast::Statement>& st, bool forceScopeForSingleStmt = false);
+    void visitStatementPossiblyBlock(ast::Statement* st, bool forceScopeForSingleStmt = false);
 
     // Final checks
-    void ensureMainExists(const ast::Funcs& root);
+    void ensureMainExists();
+
+    // Pass 2: analyzes every function body, in parallel when there are enough of them
+    void analyzeBodies(ast::Funcs& root);
+
+    // Cache key of the analysis of f, whose body is body, once every prototype is declared; none if body has a
+    // lexical error
+    std::optional<AnalysisCache::Key> cacheKey(const ast::FuncDecl& f, std::string_view body) const;
+
+    // Analyzes the body of the index-th streamed function and spills its scopes. On an error the scopes it opened
+    // are closed again before the error is passed on
+    void analyzeStreamed(ast::FuncDecl& f, std::size_t index);
 };
 
 #endif
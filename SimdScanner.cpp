@@ -0,0 +1,495 @@
+#include "SimdScanner.hpp"
+#include "output.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HW3_X86_KERNELS 1
+#endif
+
+namespace {
+
+    /* Character classes of scanner.lex */
+
+    inline bool isLetter(unsigned char c) {
+        return static_cast<unsigned char>((c | 0x20) - 'a') < 26;
+    }
+
+    inline bool isDigit(unsigned char c) {
+        return static_cast<unsigned char>(c - '0') < 10;
+    }
+
+    inline bool isSpace(unsigned char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /* Kernels
+     * Each one advances over a run of one character class and returns where the run ends (or end). The vector
+     * versions handle whole blocks and leave the last partial block to the scalar version, so they never read
+     * past end.
+     */
+    struct Kernels {
+        const char *name;
+        // Skips whitespace, adding the newlines it passed to newlines
+        const char *(*skipSpace)(const char *p, const char *end, int &newlines);
+        // Skips letters and digits
+        const char *(*skipIdentifier)(const char *p, const char *end);
+        // Finds the \r or \n that ends a // comment
+        const char *(*findLineEnd)(const char *p, const char *end);
+        // Finds the ", \ or \n that interrupts the body of a string literal
+        const char *(*findStringStop)(const char *p, const char *end);
+    };
+
+    const char *skipSpaceScalar(const char *p, const char *end, int &newlines) {
+        while (p != end && isSpace(*p)) {
+            newlines += *p == '\n';
+            ++p;
+        }
+        return p;
+    }
+
+    const char *skipIdentifierScalar(const char *p, const char *end) {
+        while (p != end && (isLetter(*p) || isDigit(*p))) {
+            ++p;
+        }
+        return p;
+    }
+
+    const char *findLineEndScalar(const char *p, const char *end) {
+        while (p != end && *p != '\n' && *p != '\r') {
+            ++p;
+        }
+        return p;
+    }
+
+    const char *findStringStopScalar(const char *p, const char *end) {
+        while (p != end && *p != '"' && *p != '\\' && *p != '\n') {
+            ++p;
+        }
+        return p;
+    }
+
+    const Kernels SCALAR = {"scalar", skipSpaceScalar, skipIdentifierScalar, findLineEndScalar, findStringStopScalar};
+
+#ifdef HW3_X86_KERNELS
+
+    /* SSE2: every x86-64 CPU has it */
+
+    inline __m128i load16(const char *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    }
+
+    inline __m128i is16(__m128i x, char c) {
+        return _mm_cmpeq_epi8(x, _mm_set1_epi8(c));
+    }
+
+    // Bytes in [lo, hi]; both bounds are ASCII, so bytes >= 0x80 (negative as signed) never match
+    inline __m128i inRange16(__m128i x, char lo, char hi) {
+        return _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                             _mm_cmplt_epi8(x, _mm_set1_epi8(static_cast<char>(hi + 1))));
+    }
+
+    inline unsigned mask16(__m128i x) {
+        return static_cast<unsigned>(_mm_movemask_epi8(x));
+    }
+
+    const char *skipSpaceSse2(const char *p, const char *end, int &newlines) {
+        while (end - p >= 16) {
+            __m128i x = load16(p);
+            __m128i nl = is16(x, '\n');
+            unsigned space = mask16(_mm_or_si128(_mm_or_si128(is16(x, ' '), is16(x, '\t')),
+                                                 _mm_or_si128(is16(x, '\r'), nl)));
+            unsigned newlineBits = mask16(nl);
+            unsigned stop = ~space & 0xFFFF;
+            if (stop) {
+                unsigned n = static_cast<unsigned>(__builtin_ctz(stop));
+                newlines += __builtin_popcount(newlineBits & ((1u << n) - 1));
+                return p + n;
+            }
+            newlines += __builtin_popcount(newlineBits);
+            p += 16;
+        }
+        return skipSpaceScalar(p, end, newlines);
+    }
+
+    const char *skipIdentifierSse2(const char *p, const char *end) {
+        while (end - p >= 16) {
+            __m128i x = load16(p);
+            __m128i letter = inRange16(_mm_or_si128(x, _mm_set1_epi8(0x20)), 'a', 'z');
+            unsigned stop = ~mask16(_mm_or_si128(letter, inRange16(x, '0', '9'))) & 0xFFFF;
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 16;
+        }
+        return skipIdentifierScalar(p, end);
+    }
+
+    const char *findLineEndSse2(const char *p, const char *end) {
+        while (end - p >= 16) {
+            __m128i x = load16(p);
+            unsigned stop = mask16(_mm_or_si128(is16(x, '\n'), is16(x, '\r')));
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 16;
+        }
+        return findLineEndScalar(p, end);
+    }
+
+    const char *findStringStopSse2(const char *p, const char *end) {
+        while (end - p >= 16) {
+            __m128i x = load16(p);
+            unsigned stop = mask16(_mm_or_si128(_mm_or_si128(is16(x, '"'), is16(x, '\\')), is16(x, '\n')));
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 16;
+        }
+        return findStringStopScalar(p, end);
+    }
+
+    const Kernels SSE2 = {"sse2", skipSpaceSse2, skipIdentifierSse2, findLineEndSse2, findStringStopSse2};
+
+    /* AVX2: compiled for the target only in these functions and picked at run time when the CPU supports it */
+
+#define HW3_AVX2 __attribute__((target("avx2")))
+
+    HW3_AVX2 inline __m256i load32(const char *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+
+    HW3_AVX2 inline __m256i is32(__m256i x, char c) {
+        return _mm256_cmpeq_epi8(x, _mm256_set1_epi8(c));
+    }
+
+    HW3_AVX2 inline __m256i inRange32(__m256i x, char lo, char hi) {
+        return _mm256_and_si256(_mm256_cmpgt_epi8(x, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                                _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), x));
+    }
+
+    HW3_AVX2 inline unsigned mask32(__m256i x) {
+        return static_cast<unsigned>(_mm256_movemask_epi8(x));
+    }
+
+    HW3_AVX2 const char *skipSpaceAvx2(const char *p, const char *end, int &newlines) {
+        while (end - p >= 32) {
+            __m256i x = load32(p);
+            __m256i nl = is32(x, '\n');
+            unsigned space = mask32(_mm256_or_si256(_mm256_or_si256(is32(x, ' '), is32(x, '\t')),
+                                                    _mm256_or_si256(is32(x, '\r'), nl)));
+            unsigned newlineBits = mask32(nl);
+            unsigned stop = ~space;
+            if (stop) {
+                unsigned n = static_cast<unsigned>(__builtin_ctz(stop));
+                newlines += __builtin_popcount(newlineBits & ((1u << n) - 1));
+                return p + n;
+            }
+            newlines += __builtin_popcount(newlineBits);
+            p += 32;
+        }
+        return skipSpaceSse2(p, end, newlines);
+    }
+
+    HW3_AVX2 const char *skipIdentifierAvx2(const char *p, const char *end) {
+        while (end - p >= 32) {
+            __m256i x = load32(p);
+            __m256i letter = inRange32(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), 'a', 'z');
+            unsigned stop = ~mask32(_mm256_or_si256(letter, inRange32(x, '0', '9')));
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 32;
+        }
+        return skipIdentifierSse2(p, end);
+    }
+
+    HW3_AVX2 const char *findLineEndAvx2(const char *p, const char *end) {
+        while (end - p >= 32) {
+            __m256i x = load32(p);
+            unsigned stop = mask32(_mm256_or_si256(is32(x, '\n'), is32(x, '\r')));
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 32;
+        }
+        return findLineEndSse2(p, end);
+    }
+
+    HW3_AVX2 const char *findStringStopAvx2(const char *p, const char *end) {
+        while (end - p >= 32) {
+            __m256i x = load32(p);
+            unsigned stop = mask32(_mm256_or_si256(_mm256_or_si256(is32(x, '"'), is32(x, '\\')), is32(x, '\n')));
+            if (stop) {
+                return p + __builtin_ctz(stop);
+            }
+            p += 32;
+        }
+        return findStringStopSse2(p, end);
+    }
+
+#undef HW3_AVX2
+
+    const Kernels AVX2 = {"avx2", skipSpaceAvx2, skipIdentifierAvx2, findLineEndAvx2, findStringStopAvx2};
+
+#endif
+
+    // The widest kernels the CPU supports. HW3_SIMD=scalar|sse2 in the environment caps the choice, which lets the
+    // narrower kernels be tested on any machine.
+    const Kernels &kernels() {
+        static const Kernels &selected = []() -> const Kernels & {
+            const char *cap = std::getenv("HW3_SIMD");
+            std::string_view limit = cap ? cap : "";
+            if (limit == "scalar") {
+                return SCALAR;
+            }
+#ifdef HW3_X86_KERNELS
+            if (limit != "sse2" && __builtin_cpu_supports("avx2")) {
+                return AVX2;
+            }
+            return SSE2;
+#else
+            return SCALAR;
+#endif
+        }();
+        return selected;
+    }
+
+    // Token of a keyword, or 0 if text is an identifier
+    int keyword(std::string_view text) {
+        switch (text.size()) {
+            case 2:
+                if (text == "or") return OR;
+                if (text == "if") return IF;
+                break;
+            case 3:
+                if (text == "int") return INT;
+                if (text == "and") return AND;
+                if (text == "not") return NOT;
+                break;
+            case 4:
+                if (text == "void") return VOID;
+                if (text == "byte") return BYTE;
+                if (text == "bool") return BOOL;
+                if (text == "true") return TRUE;
+                if (text == "else") return ELSE;
+                break;
+            case 5:
+                if (text == "false") return FALSE;
+                if (text == "while") return WHILE;
+                if (text == "break") return BREAK;
+                break;
+            case 6:
+                if (text == "return") return RETURN;
+                break;
+            case 8:
+                if (text == "continue") return CONTINUE;
+                break;
+        }
+        return 0;
+    }
+}
+
+SimdScanner::SimdScanner(ParsedProgram &program)
+        : program(&program), cur(program.source.data()), end(program.source.data() + program.source.size()) {}
+
+SimdScanner::SimdScanner(const char *begin, const char *end, int firstLine)
+        : program(nullptr), cur(begin), end(end), currentLine(firstLine) {}
+
+SimdScanner::SimdScanner(ParsedProgram &program, const char *begin, const char *end, int firstLine)
+        : program(&program), cur(begin), end(end), currentLine(firstLine) {}
+
+std::string_view SimdScanner::kernelName() {
+    return kernels().name;
+}
+
+int SimdScanner::next(YYSTYPE &value) {
+    std::string_view text;
+    int token = scan(text);
+    switch (token) {
+        case LEXICAL_ERROR:
+            output::errorLex(currentLine);
+        case ID:
+        case NUM:
+        case NUM_B:
+        case STRING:
+            makeValue(*program, token, text, currentLine, value);
+            break;
+    }
+    return token;
+}
+
+void SimdScanner::makeValue(ParsedProgram &program, int token, std::string_view text, int line, YYSTYPE &value) {
+    switch (token) {
+        case ID:
+            value.id = program.makeToken<ast::ID>(line, program.names.intern(text));
+            break;
+        case NUM:
+            value.exp = program.makeToken<ast::Num>(line, text);
+            break;
+        case NUM_B:
+            value.exp = program.makeToken<ast::NumB>(line, text);
+            break;
+        case STRING:
+            // Keep only the characters between the quotes
+            value.exp = program.makeToken<ast::String>(line, text.substr(1, text.size() - 2));
+            break;
+    }
+}
+
+std::string_view SimdScanner::skipBlock() {
+    const Kernels &k = kernels();
+    const char *start = cur;
+    const char *p = cur;
+    int depth = 1;
+    while (p != end) {
+        switch (*p) {
+            case '\n':
+                ++currentLine;
+                ++p;
+                break;
+            case '{':
+                ++depth;
+                ++p;
+                break;
+            case '}':
+                ++p;
+                if (--depth == 0) {
+                    cur = p;
+                    return {start, static_cast<std::size_t>(cur - start)};
+                }
+                break;
+            case '/':
+                p = p + 1 != end && p[1] == '/' ? k.findLineEnd(p + 2, end) : p + 1;
+                break;
+            case '"':
+                // Ends like in scan(): at the closing quote, or unterminated before a newline or the end of the text
+                ++p;
+                for (;;) {
+                    p = k.findStringStop(p, end);
+                    if (p == end || *p == '\n') {
+                        break;
+                    }
+                    if (*p == '"') {
+                        ++p;
+                        break;
+                    }
+                    if (p + 1 == end || p[1] == '\n') {
+                        ++p;
+                        break;
+                    }
+                    p += 2;
+                }
+                break;
+            default:
+                ++p;
+                break;
+        }
+    }
+    cur = p;
+    return {start, static_cast<std::size_t>(cur - start)};
+}
+
+int SimdScanner::scan(std::string_view &text) {
+    const Kernels &k = kernels();
+
+    // Whitespace and comments; tokens are often separated by a single space or none, which is not worth a kernel
+    // call
+    for (;;) {
+        if (cur != end && *cur == ' ') {
+            ++cur;
+        }
+        if (cur != end && isSpace(*cur)) {
+            cur = k.skipSpace(cur, end, currentLine);
+        }
+        if (cur == end) {
+            return 0;
+        }
+        if (cur[0] == '/' && cur + 1 != end && cur[1] == '/') {
+            cur = k.findLineEnd(cur + 2, end);
+            continue;
+        }
+        break;
+    }
+
+    const char *start = cur;
+    auto c = static_cast<unsigned char>(*cur);
+
+    if (isLetter(c)) {
+        ++cur;
+        if (cur != end && (isLetter(*cur) || isDigit(*cur))) {
+            cur = k.skipIdentifier(cur, end);
+        }
+        text = std::string_view(start, cur - start);
+        if (int token = keyword(text)) {
+            return token;
+        }
+        return ID;
+    }
+
+    if (isDigit(c)) {
+        // A literal is 0 or has no leading zero, so "012" scans as 0 followed by 12
+        ++cur;
+        if (c != '0') {
+            while (cur != end && isDigit(*cur)) {
+                ++cur;
+            }
+        }
+        bool byte = cur != end && *cur == 'b';
+        cur += byte;
+        text = std::string_view(start, cur - start);
+        return byte ? NUM_B : NUM;
+    }
+
+    if (c == '"') {
+        // Any character but a newline may follow a backslash; a newline or the end of the text inside the literal
+        // is an unterminated string
+        const char *p = cur + 1;
+        for (;;) {
+            p = k.findStringStop(p, end);
+            if (p == end || *p == '\n') {
+                return LEXICAL_ERROR;
+            }
+            if (*p == '"') {
+                break;
+            }
+            if (p + 1 == end || p[1] == '\n') {
+                return LEXICAL_ERROR;
+            }
+            p += 2;
+        }
+        cur = p + 1;
+        text = std::string_view(start, cur - start);
+        return STRING;
+    }
+
+    // Operators and punctuation; two-character operators win over their one-character prefixes
+    ++cur;
+    bool equalsNext = cur != end && *cur == '=';
+    int token = LEXICAL_ERROR;
+    switch (c) {
+        case ';': token = SC; break;
+        case ',': token = COMMA; break;
+        case '(': token = LPAREN; break;
+        case ')': token = RPAREN; break;
+        case '{': token = LBRACE; break;
+        case '}': token = RBRACE; break;
+        case '[': token = LBRACK; break;
+        case ']': token = RBRACK; break;
+        case '+': token = ADD; break;
+        case '-': token = SUB; break;
+        case '*': token = MUL; break;
+        case '/': token = DIV; break;
+        case '=': token = equalsNext ? EQ : ASSIGN; break;
+        case '<': token = equalsNext ? LE : LT; break;
+        case '>': token = equalsNext ? GE : GT; break;
+        case '!': token = equalsNext ? NE : LEXICAL_ERROR; break;
+    }
+    if (equalsNext && (token == EQ || token == LE || token == GE || token == NE)) {
+        ++cur;
+    }
+    text = std::string_view(start, cur - start);
+    return token;
+}
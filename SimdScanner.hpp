@@ -0,0 +1,62 @@
+#ifndef SIMDSCANNER_HPP
+#define SIMDSCANNER_HPP
+
+#include <string_view>
+
+#include "frontend.hpp"
+#include "parser.tab.h"
+
+/* Hand-written scanner, an alternative backend to the flex scanner in scanner.lex
+ * It returns the same tokens with the same semantic values, reports the same lexical errors and keeps the same line
+ * count, so the parser cannot tell the two apart. The runs that make up most of a program (whitespace, comments,
+ * identifiers and string literals) are classified 16 bytes at a time with SSE2, or 32 with AVX2 where the CPU has
+ * it, instead of one byte per DFA transition.
+ */
+class SimdScanner {
+public:
+    // Returned by scan() instead of a token code when the text at hand is not a token
+    static constexpr int LEXICAL_ERROR = -1;
+
+    // Scans program.source and builds token nodes into program
+    explicit SimdScanner(ParsedProgram &program);
+
+    // Scans only [begin, end), which must start at the beginning of line firstLine; such a scanner has no program,
+    // so only scan() may be used
+    SimdScanner(const char *begin, const char *end, int firstLine);
+
+    // Scans only [begin, end) of program.source, starting on line firstLine, and builds token nodes into program
+    SimdScanner(ParsedProgram &program, const char *begin, const char *end, int firstLine);
+
+    // Returns the next token, storing its node in value, or 0 at the end of the text.
+    // Lexical errors are reported through output and throw output::Aborted.
+    int next(YYSTYPE &value);
+
+    // Returns the code of the next token and sets text to its characters, without building anything. Returns 0 at
+    // the end of the text, and LEXICAL_ERROR (with line() at the offending character) on a lexical error.
+    int scan(std::string_view &text);
+
+    // Builds the node of a token that carries one (an identifier or a literal) into program
+    static void makeValue(ParsedProgram &program, int token, std::string_view text, int line, YYSTYPE &value);
+
+    // Skips the rest of a block whose { was just returned, up to and including its matching }, or to the end of the
+    // text if it has none, and returns the skipped text. Braces in comments and string literals do not count; text
+    // that is not a token is skipped like any other, and reported only when the block is scanned for real.
+    std::string_view skipBlock();
+
+    // 1 + the number of newlines consumed so far, like flex's yylineno
+    int line() const { return currentLine; }
+
+    // Where scanning resumes: just past the last token returned
+    const char *position() const { return cur; }
+
+    // Name of the classification kernels in use: "avx2", "sse2" or "scalar"
+    static std::string_view kernelName();
+
+private:
+    ParsedProgram *program;
+    const char *cur;
+    const char *end;
+    int currentLine = 1;
+};
+
+#endif //SIMDSCANNER_HPP
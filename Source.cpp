@@ -0,0 +1,100 @@
+#include "Source.hpp"
+
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Source::Source(Source &&other) noexcept
+        : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)),
+          mapped(std::exchange(other.mapped, 0)) {}
+
+Source &Source::operator=(Source &&other) noexcept {
+    if (this != &other) {
+        reset();
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+        mapped = std::exchange(other.mapped, 0);
+    }
+    return *this;
+}
+
+Source::~Source() {
+    reset();
+}
+
+void Source::reset() {
+    if (mapped) {
+        ::munmap(bytes, mapped);
+    } else {
+        delete[] bytes;
+    }
+    bytes = nullptr;
+    length = mapped = 0;
+}
+
+Source Source::copy(const char *buf, std::size_t len) {
+    Source source;
+    source.bytes = new char[len + PADDING];
+    source.length = len;
+    std::memcpy(source.bytes, buf, len);
+    std::memset(source.bytes + len, 0, PADDING);
+    return source;
+}
+
+Source Source::map(int fd) {
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0 || ::lseek(fd, 0, SEEK_CUR) != 0) {
+        return {};
+    }
+    auto len = static_cast<std::size_t>(info.st_size);
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t total = (len + PADDING + page - 1) / page * page;
+
+    // Reserve room for the padding with zeroed anonymous pages, then map the file over the start of it. The tail of
+    // the file's last page reads as zeros too, so the padding is in place whether or not the file fills that page.
+    void *region = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        return {};
+    }
+    if (::mmap(region, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        ::munmap(region, total);
+        return {};
+    }
+    ::madvise(region, len, MADV_SEQUENTIAL);
+
+    Source source;
+    source.bytes = static_cast<char *>(region);
+    source.length = len;
+    source.mapped = total;
+    return source;
+}
+
+void Source::release(const char *end) const {
+    if (!mapped) {
+        return;
+    }
+    auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t len = static_cast<std::size_t>(end - bytes) / page * page;
+    if (len > 0) {
+        ::madvise(bytes, len, MADV_DONTNEED);
+    }
+}
+
+Source Source::read(std::FILE *input) {
+    Source mappedSource = map(::fileno(input));
+    if (mappedSource.bytes) {
+        return mappedSource;
+    }
+
+    std::string text;
+    char chunk[64 * 1024];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), input)) > 0) {
+        text.append(chunk, n);
+    }
+    return copy(text.data(), text.size());
+}
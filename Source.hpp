@@ -0,0 +1,59 @@
+#ifndef SOURCE_HPP
+#define SOURCE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <string_view>
+
+/* Program text as the scanner reads it
+ * The bytes are followed by the two NUL bytes flex needs to scan a buffer in place, and stay put for the lifetime
+ * of the Source, so tokens can be views into them instead of copies. A regular file is memory-mapped (privately,
+ * since flex briefly writes a NUL after each token); anything else is read into one heap block.
+ */
+class Source {
+public:
+    Source() = default;
+
+    Source(const Source &) = delete;
+
+    Source &operator=(const Source &) = delete;
+
+    Source(Source &&other) noexcept;
+
+    Source &operator=(Source &&other) noexcept;
+
+    ~Source();
+
+    // Copies len bytes starting at buf
+    static Source copy(const char *buf, std::size_t len);
+
+    // Maps input if it is a regular file positioned at its start, otherwise reads what is left of it
+    static Source read(std::FILE *input);
+
+    // First byte of the text; data()[size()] and data()[size() + 1] are NUL
+    char *data() const { return bytes; }
+
+    // Length of the text, without the padding
+    std::size_t size() const { return length; }
+
+    std::string_view text() const { return {bytes, length}; }
+
+    // Lets the kernel reclaim the memory holding the text before end, if the text is mapped; it is read from the
+    // file again when touched. Only for text no scanner has written to
+    void release(const char *end) const;
+
+private:
+    static constexpr std::size_t PADDING = 2;
+
+    char *bytes = nullptr;
+    std::size_t length = 0;
+    // Size of the mapping, or 0 when the bytes are on the heap
+    std::size_t mapped = 0;
+
+    // Maps the file behind fd, or returns an empty Source if it cannot be mapped
+    static Source map(int fd);
+
+    void reset();
+};
+
+#endif //SOURCE_HPP
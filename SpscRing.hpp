@@ -0,0 +1,83 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+/* Bounded lock-free queue between exactly one producer thread and one consumer thread
+ * The two indices only grow and live on separate cache lines; each side also keeps a private copy of the other
+ * side's index and reloads it only when the ring looks full (or empty), so in the steady state a push or pop touches
+ * no cache line the other thread is writing. A side that has to wait spins briefly, then yields its CPU.
+ */
+template<typename T>
+class SpscRing {
+public:
+    // capacity is rounded up to a power of two
+    explicit SpscRing(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots = std::make_unique<T[]>(size);
+        mask = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // Producer: appends item, waiting for room; gives up and returns false once cancelled is set
+    bool push(const T &item, const std::atomic<bool> &cancelled) {
+        std::size_t tail = producer.index.load(std::memory_order_relaxed);
+        for (unsigned spins = 0; tail - producer.otherIndex > mask; ++spins) {
+            producer.otherIndex = consumer.index.load(std::memory_order_acquire);
+            if (tail - producer.otherIndex > mask) {
+                if (cancelled.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                backOff(spins);
+            }
+        }
+        slots[tail & mask] = item;
+        producer.index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: removes the oldest item, waiting for one to be pushed
+    T pop() {
+        std::size_t head = consumer.index.load(std::memory_order_relaxed);
+        for (unsigned spins = 0; head == consumer.otherIndex; ++spins) {
+            consumer.otherIndex = producer.index.load(std::memory_order_acquire);
+            if (head == consumer.otherIndex) {
+                backOff(spins);
+            }
+        }
+        T item = slots[head & mask];
+        consumer.index.store(head + 1, std::memory_order_release);
+        return item;
+    }
+
+private:
+    // One side's state, alone on its cache line
+    struct alignas(64) Side {
+        // Items this side has pushed (producer) or popped (consumer)
+        std::atomic<std::size_t> index{0};
+        // Last value seen of the other side's index
+        std::size_t otherIndex = 0;
+    };
+
+    Side producer;
+    Side consumer;
+    std::unique_ptr<T[]> slots;
+    std::size_t mask;
+
+    static void backOff(unsigned spins) {
+        if (spins >= 64) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+#endif //SPSCRING_HPP
@@ -0,0 +1,306 @@
+#include "Stats.hpp"
+#include "static_visitor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+#include <sstream>
+#include <sys/resource.h>
+
+namespace {
+    // Set by the first Stats; until then, and in runs without --stats, allocations only test it
+    std::atomic<bool> counting(false);
+    std::atomic<std::uint64_t> allocations(0);
+    std::atomic<std::uint64_t> allocatedBytes(0);
+
+    const char *const PHASE_NAMES[] = {"parse", "pass 1", "pass 2", "fold", "render", "lower", "run"};
+    const char *const PHASE_KEYS[] = {"parse", "pass1", "pass2", "fold", "render", "lower", "run"};
+    const char *const KIND_NAMES[] = {
+            "Num", "NumB", "String", "Bool", "ID", "BinOp", "RelOp", "Not", "And", "Or", "Type", "Cast", "ExpList",
+            "Call", "Statements", "Break", "Continue", "Return", "If", "While", "VarDecl", "Assign", "Formal",
+            "Formals", "FuncDecl", "Funcs"
+    };
+
+    std::chrono::nanoseconds cpuTime() {
+        timespec now{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+        return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+    }
+
+    // Peak resident set of the process so far, in kB
+    long peakRss() {
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+    }
+
+    double milliseconds(std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    }
+
+    /* Counts the nodes of a tree by kind */
+    class NodeCounter : public StaticVisitor<NodeCounter> {
+    public:
+        explicit NodeCounter(std::uint64_t *counts) : counts(counts) {}
+
+        void count(ast::Node *node) {
+            if (node != nullptr) {
+                dispatch(*node);
+            }
+        }
+
+        template<typename T>
+        void visit(T &node) {
+            ++counts[static_cast<std::size_t>(node.kind)];
+            children(node);
+        }
+
+    private:
+        std::uint64_t *counts;
+
+        void children(ast::Node &) {}
+
+        template<typename T>
+        void children(const ast::List<T> &list) {
+            for (auto &item: list) {
+                count(item);
+            }
+        }
+
+        void children(ast::BinOp &node) { count(node.left); count(node.right); }
+
+        void children(ast::RelOp &node) { count(node.left); count(node.right); }
+
+        void children(ast::Not &node) { count(node.exp); }
+
+        void children(ast::And &node) { count(node.left); count(node.right); }
+
+        void children(ast::Or &node) { count(node.left); count(node.right); }
+
+        void children(ast::Cast &node) { count(node.exp); count(node.target_type); }
+
+        void children(ast::ExpList &node) { children(node.exps); }
+
+        void children(ast::Call &node) { count(node.func_id); count(node.args); }
+
+        void children(ast::Statements &node) { children(node.statements); }
+
+        void children(ast::Return &node) { count(node.exp); }
+
+        void children(ast::If &node) { count(node.condition); count(node.then); count(node.otherwise); }
+
+        void children(ast::While &node) { count(node.condition); count(node.body); }
+
+        void children(ast::VarDecl &node) { count(node.id); count(node.type); count(node.init_exp); }
+
+        void children(ast::Assign &node) { count(node.id); count(node.exp); }
+
+        void children(ast::Formal &node) { count(node.id); count(node.type); }
+
+        void children(ast::Formals &node) { children(node.formals); }
+
+        void children(ast::FuncDecl &node) {
+            count(node.id);
+            count(node.return_type);
+            count(node.formals);
+            count(node.body);
+        }
+
+        void children(ast::Funcs &node) { children(node.funcs); }
+    };
+}
+
+// Every allocation through new passes here, so that --stats can count them
+void *operator new(std::size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    for (;;) {
+        if (void *p = std::malloc(size)) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+// The library's temporary buffers (std::stable_sort) come from here; they must also be counted, and be freed by the
+// operator delete below
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    try {
+        return operator new(size);
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+Stats::Timer::Timer(Stats *stats, Phase phase) : stats(stats), phase(phase) {
+    if (stats) {
+        wall = std::chrono::steady_clock::now();
+        cpu = cpuTime();
+    }
+}
+
+Stats::Timer::~Timer() {
+    if (stats) {
+        stats->wall[phase] += std::chrono::steady_clock::now() - wall;
+        stats->cpu[phase] += cpuTime() - cpu;
+    }
+}
+
+Stats::Stats() {
+    counting.store(true, std::memory_order_relaxed);
+    allocationsBefore = allocations.load(std::memory_order_relaxed);
+    bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+}
+
+void Stats::countNodes(const ast::Node &root) {
+    NodeCounter(nodes).count(const_cast<ast::Node *>(&root));
+}
+
+void Stats::countFolded(const ast::Node &root, const folding::Counters &counters) {
+    NodeCounter(foldedNodes).count(const_cast<ast::Node *>(&root));
+    folding.folded += counters.folded;
+    folding.propagated += counters.propagated;
+    folding.dropped += counters.dropped;
+    folding.zeroDivisions += counters.zeroDivisions;
+    folded = true;
+}
+
+void Stats::countArenas(const ast::Arena &nodes, const ast::Arena &tokens) {
+    arenaUsed = std::max(arenaUsed, nodes.bytesUsed() + tokens.bytesUsed());
+    arenaReserved = std::max(arenaReserved, nodes.bytesReserved() + tokens.bytesReserved());
+}
+
+void Stats::addSymbols(const SymbolTable::Counters &counters) {
+    std::lock_guard<std::mutex> lock(symbolsLock);
+    symbols.declares += counters.declares;
+    symbols.lookups += counters.lookups;
+    symbols.scopes += counters.scopes;
+    if (counters.peakDepth > symbols.peakDepth) {
+        symbols.peakDepth = counters.peakDepth;
+    }
+}
+
+void Stats::print(std::ostream &os, StatsFormat format, const std::string &input) const {
+    // Composed first and written at once, so that the reports of files checked in parallel do not interleave
+    std::ostringstream report;
+    if (format == StatsFormat::Json) {
+        printJson(report, input);
+    } else if (format == StatsFormat::Text) {
+        printText(report, input);
+    }
+    os << report.str() << std::flush;
+}
+
+void Stats::printText(std::ostream &os, const std::string &input) const {
+    char line[96];
+    os << "--- hw3 stats" << (input.empty() ? "" : ": " + input) << " ---\n";
+    std::snprintf(line, sizeof(line), "%-18s %12s %12s\n", "phase", "wall ms", "cpu ms");
+    os << line;
+    for (int p = 0; p < PHASES; ++p) {
+        std::snprintf(line, sizeof(line), "%-18s %12.3f %12.3f\n", PHASE_NAMES[p], milliseconds(wall[p]),
+                      milliseconds(cpu[p]));
+        os << line;
+    }
+
+    auto row = [&](const char *name, unsigned long long value) {
+        std::snprintf(line, sizeof(line), "%-18s %12llu\n", name, value);
+        os << line;
+    };
+    auto kinds = [&](const char *name, const std::uint64_t *counts) {
+        std::uint64_t total = 0;
+        for (std::size_t k = 0; k < KINDS; ++k) {
+            total += counts[k];
+        }
+        row(name, total);
+        for (std::size_t k = 0; k < KINDS; ++k) {
+            if (counts[k] != 0) {
+                std::snprintf(line, sizeof(line), "  %-16s %12llu\n", KIND_NAMES[k],
+                              static_cast<unsigned long long>(counts[k]));
+                os << line;
+            }
+        }
+    };
+    kinds("nodes", nodes);
+    if (folded) {
+        kinds("nodes after fold", foldedNodes);
+        row("folded exps", folding.folded);
+        row("propagated reads", folding.propagated);
+        row("dropped declares", folding.dropped);
+        row("zero divisions", folding.zeroDivisions);
+    }
+    row("symbol declares", symbols.declares);
+    row("symbol lookups", symbols.lookups);
+    row("scopes pushed", symbols.scopes);
+    row("peak scope depth", symbols.peakDepth);
+    row("vm instructions", instructions);
+    row("heap allocations", allocations.load(std::memory_order_relaxed) - allocationsBefore);
+    row("heap bytes", allocatedBytes.load(std::memory_order_relaxed) - bytesBefore);
+    row("arena used", arenaUsed);
+    row("arena reserved", arenaReserved);
+    row("peak RSS kB", static_cast<unsigned long long>(peakRss()));
+}
+
+void Stats::printJson(std::ostream &os, const std::string &input) const {
+    char number[32];
+    os << "{";
+    if (!input.empty()) {
+        os << "\"input\":\"";
+        for (char c: input) {
+            if (c == '"' || c == '\\') {
+                os << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                std::snprintf(number, sizeof(number), "\\u%04x", c);
+                os << number;
+            } else {
+                os << c;
+            }
+        }
+        os << "\",";
+    }
+    os << "\"phases\":{";
+    for (int p = 0; p < PHASES; ++p) {
+        std::snprintf(number, sizeof(number), "%.3f", milliseconds(wall[p]));
+        os << (p ? "," : "") << "\"" << PHASE_KEYS[p] << "\":{\"wall_ms\":" << number;
+        std::snprintf(number, sizeof(number), "%.3f", milliseconds(cpu[p]));
+        os << ",\"cpu_ms\":" << number << "}";
+    }
+    os << "},\"nodes\":{";
+    for (std::size_t k = 0; k < KINDS; ++k) {
+        os << (k ? "," : "") << "\"" << KIND_NAMES[k] << "\":" << nodes[k];
+    }
+    if (folded) {
+        os << "},\"folded_nodes\":{";
+        for (std::size_t k = 0; k < KINDS; ++k) {
+            os << (k ? "," : "") << "\"" << KIND_NAMES[k] << "\":" << foldedNodes[k];
+        }
+        os << "},\"folding\":{\"folded\":" << folding.folded << ",\"propagated\":" << folding.propagated
+           << ",\"dropped\":" << folding.dropped << ",\"zero_divisions\":" << folding.zeroDivisions;
+    }
+    os << "},\"symbols\":{\"declares\":" << symbols.declares << ",\"lookups\":" << symbols.lookups
+       << "},\"scopes\":{\"pushed\":" << symbols.scopes << ",\"peak_depth\":" << symbols.peakDepth
+       << "},\"vm\":{\"instructions\":" << instructions
+       << "},\"heap\":{\"allocations\":" << allocations.load(std::memory_order_relaxed) - allocationsBefore
+       << ",\"bytes\":" << allocatedBytes.load(std::memory_order_relaxed) - bytesBefore
+       << "},\"arena\":{\"used\":" << arenaUsed << ",\"reserved\":" << arenaReserved
+       << "},\"peak_rss_kb\":" << peakRss() << "}\n";
+}
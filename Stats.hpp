@@ -0,0 +1,117 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "Folding.hpp"
+#include "nodes.hpp"
+#include "SymbolTable.hpp"
+
+/* How --stats reports */
+enum class StatsFormat {
+    None,
+    // A table for people
+    Text,
+    // One JSON object per program, for tools
+    Json
+};
+
+/* Measurements of one compilation, reported by --stats
+ * Whoever checks a program with stats passes a Stats to the phases, which time themselves and count their work into
+ * it; without stats they are handed nullptr and skip all of it, symbol tables included, so the only cost left is a
+ * null test where a phase would count and one flag test per heap allocation. CPU time, heap allocations and peak RSS
+ * are counted for the whole process: in batch mode they include the work of the files checked at the same time. The
+ * heap figures count what goes through operator new, which the arenas of the tree bypass: their blocks are reported
+ * on their own, per program.
+ */
+class Stats {
+public:
+    enum Phase {
+        // Scanning and parsing, or loading an AST image
+        PARSE,
+        // Declaring the prototypes and checking main
+        PASS1,
+        // Analyzing the bodies
+        PASS2,
+        // Folding constants, before the backends that run or write the program (see Folding)
+        FOLD,
+        // Writing the scopes
+        RENDER,
+        // Lowering the program to bytecode, with --run, and on to assembly with --emit-asm; writing LLVM IR with
+        // --emit-llvm and C with --emit-c
+        LOWER,
+        // Running the bytecode
+        RUN,
+        PHASES
+    };
+
+    /* Adds the wall-clock and CPU time from its construction to its destruction to a phase of stats, if any */
+    class Timer {
+    public:
+        Timer(Stats *stats, Phase phase);
+
+        Timer(const Timer &) = delete;
+
+        Timer &operator=(const Timer &) = delete;
+
+        ~Timer();
+
+    private:
+        Stats *stats;
+        Phase phase;
+        std::chrono::steady_clock::time_point wall;
+        std::chrono::nanoseconds cpu;
+    };
+
+    // Starts counting heap allocations, which stay counted until the process exits
+    Stats();
+
+    // Counts the nodes of the tree under root by kind
+    void countNodes(const ast::Node &root);
+
+    // Counts the nodes of the tree under root by kind once folding has changed it as counters say
+    void countFolded(const ast::Node &root, const folding::Counters &counters);
+
+    // Adds the counters of a symbol table; may be called from any thread
+    void addSymbols(const SymbolTable::Counters &counters);
+
+    // Records the bytes the arenas of a program, its tree's and its scanner's, use and reserve together. Arenas
+    // rewound between calls shrink, so the largest figures seen are kept
+    void countArenas(const ast::Arena &nodes, const ast::Arena &tokens);
+
+    // Adds the instructions the bytecode VM executed
+    void addInstructions(std::uint64_t count) { instructions += count; }
+
+    // Writes the report, naming the program input when it is not empty
+    void print(std::ostream &os, StatsFormat format, const std::string &input = "") const;
+
+private:
+    static constexpr std::size_t KINDS = static_cast<std::size_t>(ast::NodeKind::Funcs) + 1;
+
+    std::chrono::nanoseconds wall[PHASES]{};
+    std::chrono::nanoseconds cpu[PHASES]{};
+    std::uint64_t nodes[KINDS]{};
+    // After folding, if the program was folded
+    bool folded = false;
+    std::uint64_t foldedNodes[KINDS]{};
+    folding::Counters folding{0, 0, 0, 0};
+    std::uint64_t instructions = 0;
+    std::size_t arenaUsed = 0;
+    std::size_t arenaReserved = 0;
+
+    std::mutex symbolsLock;
+    SymbolTable::Counters symbols{0, 0, 0, 0};
+
+    std::uint64_t allocationsBefore;
+    std::uint64_t bytesBefore;
+
+    void printText(std::ostream &os, const std::string &input) const;
+
+    void printJson(std::ostream &os, const std::string &input) const;
+};
+
+#endif //STATS_HPP
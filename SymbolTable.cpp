@@ -0,0 +1,68 @@
+#include "SymbolTable.hpp"
+
+SymbolTable::SymbolTable(const SymbolTable *outer) : outer(outer) {
+    marks.push_back(0);
+}
+
+void SymbolTable::pushScope() {
+    marks.push_back(records.size());
+    if (counted) {
+        ++counted->scopes;
+        if (marks.size() > counted->peakDepth) {
+            counted->peakDepth = marks.size();
+        }
+    }
+}
+
+void SymbolTable::popScope() {
+    if (marks.size() <= 1) {
+        return;
+    }
+    std::size_t mark = marks.back();
+    marks.pop_back();
+
+    while (records.size() > mark) {
+        const Record &r = records.back();
+        visible[r.entry.name] = r.shadowed;
+        records.pop_back();
+    }
+}
+
+const SymbolEntry *SymbolTable::lookup(ast::SymbolId name) const {
+    if (counted) {
+        ++counted->lookups;
+    }
+    return resolve(name);
+}
+
+const SymbolEntry *SymbolTable::resolve(ast::SymbolId name) const {
+    std::uint32_t r = find(name);
+    if (r != NONE) {
+        return &records[r].entry;
+    }
+    return outer ? outer->resolve(name) : nullptr;
+}
+
+bool SymbolTable::existsInCurrentScope(ast::SymbolId name) const {
+    std::uint32_t r = find(name);
+    return r != NONE && records[r].scope == marks.size() - 1;
+}
+
+SymbolEntry *SymbolTable::declare(ast::SymbolId name) {
+    std::uint32_t r = find(name);
+    if (r != NONE || (outer && outer->resolve(name))) {
+        return nullptr;
+    }
+    if (counted) {
+        ++counted->declares;
+    }
+
+    if (name >= visible.size()) {
+        visible.resize(name + 1 > 2 * visible.size() ? name + 1 : 2 * visible.size(), NONE);
+    }
+
+    visible[name] = static_cast<std::uint32_t>(records.size());
+    records.push_back({SymbolEntry(), r, static_cast<std::uint32_t>(marks.size() - 1)});
+    records.back().entry.name = name;
+    return &records.back().entry;
+}
@@ -0,0 +1,97 @@
+#ifndef SYMBOLTABLE_HPP
+#define SYMBOLTABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "nodes.hpp"
+
+struct SymbolEntry {
+    ast::SymbolId name = 0;
+    bool isFunc = false;
+
+    // For vars: var type
+    // For funcs: return type
+    ast::BuiltInType type = ast::BuiltInType::VOID;
+
+    // Only for funcs
+    std::vector<ast::BuiltInType> paramTypes;
+
+    // Only for vars/params
+    int offset = 0;
+};
+
+/* Scoped symbol table
+ * Identifiers are interned, so all scopes share one table indexed directly by SymbolId and a lookup is a single
+ * array access no matter how deeply scopes are nested. Declarations are kept on a stack that doubles as an undo
+ * log: popScope() walks back to the mark taken by the matching pushScope() and restores whatever each entry
+ * shadowed.
+ * A table may sit on top of a frozen outer table (the global scope shared by every function analyzed in
+ * parallel): names it does not declare itself are looked up there, and the outer table is never written.
+ */
+class SymbolTable {
+public:
+    /* Work done by a table, reported by --stats */
+    struct Counters {
+        std::uint64_t declares = 0;
+        std::uint64_t lookups = 0;
+        // pushScope() calls
+        std::uint64_t scopes = 0;
+        // Most scopes open at once, the global scope included
+        std::size_t peakDepth = 1;
+    };
+
+    explicit SymbolTable(const SymbolTable *outer = nullptr);
+
+    void pushScope();
+
+    void popScope();
+
+    // Number of open scopes, the global scope included
+    std::size_t depth() const { return marks.size(); }
+
+    // Innermost visible entry for name, or nullptr
+    const SymbolEntry *lookup(ast::SymbolId name) const;
+
+    bool existsInCurrentScope(ast::SymbolId name) const;
+
+    // Declares name in the current scope and returns its new entry, or nullptr if name is already visible
+    SymbolEntry *declare(ast::SymbolId name);
+
+    // Counts the table's work into counters from now on; with nullptr, the default, nothing is counted, so that
+    // without --stats a lookup stays a single array access
+    void countInto(Counters *counters) { counted = counters; }
+
+private:
+    static constexpr std::uint32_t NONE = UINT32_MAX;
+
+    const SymbolTable *outer;
+
+    struct Record {
+        SymbolEntry entry;
+        // Record that was visible under the same name before this one
+        std::uint32_t shadowed;
+        std::uint32_t scope;
+    };
+
+    // Index into records of the visible declaration of each SymbolId
+    std::vector<std::uint32_t> visible;
+    // Declarations in order; a deque keeps returned entry pointers stable while it grows
+    std::deque<Record> records;
+    // records.size() at every pushScope(), the global scope being marks[0]
+    std::vector<std::size_t> marks;
+    // An outer table is only read through resolve(), which counts nothing, so tables on other threads never write
+    // its counters
+    Counters *counted = nullptr;
+
+    // lookup() without counting
+    const SymbolEntry *resolve(ast::SymbolId name) const;
+
+    std::uint32_t find(ast::SymbolId name) const {
+        return name < visible.size() ? visible[name] : NONE;
+    }
+};
+
+#endif //SYMBOLTABLE_HPP
@@ -0,0 +1,133 @@
+#include "TokenArray.hpp"
+#include "SimdScanner.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace {
+    // Smallest chunk worth a thread of its own
+    constexpr std::size_t MIN_CHUNK_SIZE = 1 << 20;
+
+    struct Chunk {
+        Chunk(const char *begin, const char *end) : begin(begin), end(end) {}
+
+        const char *begin;
+        const char *end;
+        // Tokens with lines counted from 1 at begin
+        TokenArray tokens;
+        int newlines = 0;
+        bool failed = false;
+        // Where the chunk's tokens go in the merged array, and the line its first line becomes
+        std::size_t first = 0;
+        int firstLine = 1;
+    };
+
+    void lexChunk(const char *base, Chunk &chunk) {
+        trace::Span span("lex chunk");
+        SimdScanner scanner(chunk.begin, chunk.end, 1);
+        TokenArray &tokens = chunk.tokens;
+        // Tokens in this code average three to four bytes of source, whitespace included; reserving for the denser
+        // end saves growing (and copying) all four arrays halfway through
+        std::size_t expected = static_cast<std::size_t>(chunk.end - chunk.begin) / 3 + 16;
+        tokens.kinds.reserve(expected);
+        tokens.offsets.reserve(expected);
+        tokens.lengths.reserve(expected);
+        tokens.lines.reserve(expected);
+
+        std::string_view text;
+        while (int token = scanner.scan(text)) {
+            if (token == SimdScanner::LEXICAL_ERROR) {
+                text = {};
+                chunk.failed = true;
+            }
+            tokens.kinds.push_back(static_cast<std::int16_t>(token));
+            tokens.offsets.push_back(text.empty() ? 0 : static_cast<std::uint32_t>(text.data() - base));
+            tokens.lengths.push_back(static_cast<std::uint32_t>(text.size()));
+            tokens.lines.push_back(scanner.line());
+            if (chunk.failed) {
+                break;
+            }
+        }
+        chunk.newlines = scanner.line() - 1;
+    }
+
+    // Runs work(i) for every i below count, one thread each
+    template<typename Work>
+    void runEach(std::size_t count, Work work) {
+        if (count == 0) {
+            return;
+        }
+        std::vector<std::thread> pool;
+        for (std::size_t i = 1; i < count; ++i) {
+            pool.emplace_back(work, i);
+        }
+        work(0);
+        for (auto &thread: pool) {
+            thread.join();
+        }
+    }
+}
+
+TokenArray TokenArray::lex(const Source &source, unsigned jobs) {
+    trace::Span span("lex");
+    const char *base = source.data();
+    const std::size_t size = source.size();
+
+    std::size_t threads = jobs ? jobs : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, size / MIN_CHUNK_SIZE));
+
+    // Cut after the first newline at or past each even split point
+    std::vector<Chunk> chunks;
+    const char *begin = base;
+    for (std::size_t i = 1; i <= threads && begin != base + size; ++i) {
+        const char *end = base + size;
+        if (i < threads) {
+            const char *target = std::max(begin, base + size / threads * i);
+            auto *newline = static_cast<const char *>(std::memchr(target, '\n', base + size - target));
+            end = newline ? newline + 1 : base + size;
+        }
+        chunks.emplace_back(begin, end);
+        begin = end;
+    }
+
+    runEach(chunks.size(), [&](std::size_t i) { lexChunk(base, chunks[i]); });
+
+    // Chunks after the first failing one are never reached by the parser
+    std::size_t total = 0;
+    std::size_t used = 0;
+    int line = 1;
+    while (used < chunks.size()) {
+        Chunk &chunk = chunks[used++];
+        chunk.first = total;
+        chunk.firstLine = line;
+        total += chunk.tokens.size();
+        line += chunk.newlines;
+        if (chunk.failed) {
+            break;
+        }
+    }
+    if (used == 0) {
+        return {};
+    }
+
+    // The first chunk's lines already count from 1, so its arrays become the result and only the rest are copied
+    TokenArray result = std::move(chunks[0].tokens);
+    result.endLine = line;
+    result.kinds.resize(total);
+    result.offsets.resize(total);
+    result.lengths.resize(total);
+    result.lines.resize(total);
+
+    runEach(used - 1, [&](std::size_t i) {
+        const Chunk &chunk = chunks[i + 1];
+        const TokenArray &from = chunk.tokens;
+        std::copy(from.kinds.begin(), from.kinds.end(), result.kinds.begin() + chunk.first);
+        std::copy(from.offsets.begin(), from.offsets.end(), result.offsets.begin() + chunk.first);
+        std::copy(from.lengths.begin(), from.lengths.end(), result.lengths.begin() + chunk.first);
+        std::transform(from.lines.begin(), from.lines.end(), result.lines.begin() + chunk.first,
+                       [&](std::int32_t l) { return l + chunk.firstLine - 1; });
+    });
+    return result;
+}
@@ -0,0 +1,35 @@
+#ifndef TOKENARRAY_HPP
+#define TOKENARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Source.hpp"
+
+/* Tokens of a whole program, lexed before parsing starts
+ * Stored as a struct of arrays: token i has code kinds[i], its text is the lengths[i] bytes at offsets[i] in the
+ * source, and it is on line lines[i]. A lexical error ends the array with a SimdScanner::LEXICAL_ERROR entry on the
+ * line of the offending character, so the parser meets it exactly where a pulling scanner would have reported it.
+ */
+struct TokenArray {
+    std::vector<std::int16_t> kinds;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> lengths;
+    std::vector<std::int32_t> lines;
+    // Line count at the end of the text, which is the line of end of input
+    int endLine = 1;
+
+    std::size_t size() const { return kinds.size(); }
+
+    // Largest source lex() accepts, since offsets are 32-bit
+    static constexpr std::size_t MAX_SOURCE = UINT32_MAX;
+
+    // Lexes source with the SIMD scanner, split into chunks that are scanned on up to jobs threads (0: one per
+    // hardware thread). The text is cut only after newlines: no token, comment or string literal spans a newline,
+    // so every chunk starts in the scanner's initial state and needs nothing from the chunk before it but the
+    // number of newlines in it.
+    static TokenArray lex(const Source &source, unsigned jobs);
+};
+
+#endif //TOKENARRAY_HPP
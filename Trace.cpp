@@ -0,0 +1,163 @@
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace trace {
+    std::atomic<bool> detail::recording(false);
+
+    namespace {
+        /* One logged span */
+        struct Event {
+            const char *name;
+            std::uint64_t start;
+            std::uint64_t end;
+            int line;
+            std::uint8_t detailLength;
+            char detail[43];
+        };
+
+        /* Events of one thread, in chunks that never move */
+        struct Log {
+            static constexpr std::size_t CHUNK = 4096;
+
+            std::uint32_t tid;
+            std::vector<std::unique_ptr<Event[]>> chunks;
+            // Events in the last chunk
+            std::size_t used = CHUNK;
+
+            explicit Log(std::uint32_t tid) : tid(tid) {}
+
+            Event &append() {
+                if (used == CHUNK) {
+                    chunks.emplace_back(new Event[CHUNK]);
+                    used = 0;
+                }
+                return chunks.back()[used++];
+            }
+        };
+
+        // Every thread's log, kept until the trace is written even when the thread has ended
+        std::mutex logsLock;
+        std::vector<std::unique_ptr<Log>> logs;
+        thread_local Log *threadLog = nullptr;
+
+        std::string tracePath;
+        std::uint64_t minScope = 0;
+        std::uint64_t origin = 0;
+
+        Log &log() {
+            if (threadLog == nullptr) {
+                std::lock_guard<std::mutex> lock(logsLock);
+                logs.push_back(std::make_unique<Log>(static_cast<std::uint32_t>(logs.size() + 1)));
+                threadLog = logs.back().get();
+            }
+            return *threadLog;
+        }
+
+        void writeString(std::ostream &os, std::string_view text) {
+            os << '"';
+            for (char c: text) {
+                if (c == '"' || c == '\\') {
+                    os << '\\' << c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    os << escaped;
+                } else {
+                    os << c;
+                }
+            }
+            os << '"';
+        }
+
+        // Microseconds since recording started, as the trace format counts
+        void writeMicros(std::ostream &os, std::uint64_t nanos) {
+            char number[32];
+            std::snprintf(number, sizeof(number), "%.3f", static_cast<double>(nanos) / 1000.0);
+            os << number;
+        }
+    }
+
+    std::uint64_t now() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    void start(std::string path, std::uint64_t minScopeMicros) {
+        tracePath = std::move(path);
+        minScope = minScopeMicros * 1000;
+        origin = now();
+        // The thread that records the run comes first in the trace
+        log();
+        detail::recording.store(true, std::memory_order_relaxed);
+    }
+
+    void complete(const char *name, std::uint64_t start, std::uint64_t end, std::string_view detail, int line) {
+        Event &event = log().append();
+        event.name = name;
+        event.start = start;
+        event.end = end;
+        event.line = line;
+        event.detailLength = static_cast<std::uint8_t>(std::min(detail.size(), sizeof(event.detail)));
+        if (event.detailLength != 0) {
+            std::memcpy(event.detail, detail.data(), event.detailLength);
+        }
+    }
+
+    void scope(std::uint64_t start, std::string_view function) {
+        std::uint64_t end = now();
+        if (end - start >= minScope) {
+            complete("scope", start, end, function);
+        }
+    }
+
+    bool finish() {
+        detail::recording.store(false, std::memory_order_relaxed);
+        std::ofstream os(tracePath, std::ios::binary);
+        os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (const auto &threadEvents: logs) {
+            const Log &events = *threadEvents;
+            for (std::size_t c = 0; c < events.chunks.size(); ++c) {
+                std::size_t count = c + 1 == events.chunks.size() ? events.used : Log::CHUNK;
+                for (std::size_t i = 0; i < count; ++i) {
+                    const Event &event = events.chunks[c][i];
+                    os << (first ? "" : ",\n") << "{\"name\":";
+                    writeString(os, event.name);
+                    os << ",\"cat\":\"hw3\",\"ph\":\"X\",\"pid\":1,\"tid\":" << events.tid << ",\"ts\":";
+                    writeMicros(os, event.start - origin);
+                    os << ",\"dur\":";
+                    writeMicros(os, event.end - event.start);
+                    if (event.detailLength != 0 || event.line > 0) {
+                        os << ",\"args\":{";
+                        if (event.detailLength != 0) {
+                            os << "\"name\":";
+                            writeString(os, {event.detail, event.detailLength});
+                        }
+                        if (event.line > 0) {
+                            os << (event.detailLength != 0 ? "," : "") << "\"line\":" << event.line;
+                        }
+                        os << "}";
+                    }
+                    os << "}";
+                    first = false;
+                }
+            }
+        }
+        os << "\n]}\n";
+        os.flush();
+        if (!os) {
+            std::cerr << "hw3: cannot write " << tracePath << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/* Chrome trace-event export, for --trace
+ * While recording, spans of the pipeline (lexing, parsing, the analysis of each function, long scopes, rendering)
+ * are logged with the thread that ran them, and finish() writes them as a JSON trace that chrome://tracing and
+ * Perfetto open. Each thread appends to a log of its own, which only its first event registers under a lock, so
+ * recording costs two clock reads and a copy per span; when not recording, a span costs one flag test.
+ */
+namespace trace {
+    namespace detail {
+        extern std::atomic<bool> recording;
+    }
+
+    // Starts recording for the rest of the process. Scopes are logged when they stay open at least minScopeMicros
+    void start(std::string path, std::uint64_t minScopeMicros);
+
+    // Stops recording and writes the trace; returns false, after printing why to stderr, if it cannot be written.
+    // Every thread that recorded must have been joined
+    bool finish();
+
+    inline bool recording() {
+        return detail::recording.load(std::memory_order_relaxed);
+    }
+
+    // Monotonic clock, in nanoseconds
+    std::uint64_t now();
+
+    // Logs a span of the calling thread from start to end. detail names what the span worked on (a function, a
+    // file) and is cut to fit the log; line is shown when positive
+    void complete(const char *name, std::uint64_t start, std::uint64_t end, std::string_view detail = {},
+                  int line = 0);
+
+    // Logs a scope that opened at start and closes now, if it stayed open long enough
+    void scope(std::uint64_t start, std::string_view function);
+
+    /* Logs the span from its construction to its destruction, if recording; name must be a literal */
+    class Span {
+    public:
+        explicit Span(const char *name, std::string_view detail = {}, int line = 0)
+                : name(name), detail(detail), line(line), start(recording() ? now() : 0) {}
+
+        Span(const Span &) = delete;
+
+        Span &operator=(const Span &) = delete;
+
+        ~Span() {
+            if (start != 0) {
+                complete(name, start, now(), detail, line);
+            }
+        }
+
+    private:
+        const char *name;
+        std::string_view detail;
+        int line;
+        std::uint64_t start;
+    };
+}
+
+#endif //TRACE_HPP
@@ -0,0 +1,214 @@
+#include "Vm.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__GNUC__)
+#define HW3_THREADED_VM 1
+#else
+#define HW3_THREADED_VM 0
+#endif
+
+namespace bytecode {
+    namespace {
+        /* Instruction as it is run */
+        struct Threaded {
+#if HW3_THREADED_VM
+            const void *handler;
+#else
+            Op op;
+#endif
+            std::int32_t a;
+            std::int32_t b;
+            std::int32_t c;
+        };
+
+        /* Caller of the running function, and where its result goes */
+        struct Frame {
+            const Threaded *ret;
+            std::size_t base;
+            std::int32_t dst;
+        };
+
+        std::int32_t wrap(std::uint32_t value) {
+            return static_cast<std::int32_t>(value);
+        }
+
+        template<bool Counted>
+        std::uint64_t execute(const Program &program, std::ostream &out) {
+            std::uint64_t executed = 0;
+#if HW3_THREADED_VM
+            // In the order of Op
+            static const void *const handlers[] = {
+                    &&LOADI, &&MOVE, &&ADD, &&SUB, &&MUL, &&DIV, &&ADDI, &&TRUNC, &&JMP, &&JT, &&JF, &&JEQ, &&JNE,
+                    &&JLT, &&JGT, &&JLE, &&JGE, &&CALL, &&RET, &&RETV, &&PRINT, &&PRINTI
+            };
+            static_assert(sizeof(handlers) / sizeof(*handlers) == OPS, "a handler for every op");
+#define DISPATCH() do { if (Counted) ++executed; goto *pc->handler; } while (0)
+#else
+#define DISPATCH() do { if (Counted) ++executed; goto dispatch; } while (0)
+#endif
+#define NEXT() do { ++pc; DISPATCH(); } while (0)
+#define JUMP(target) do { pc = code.data() + (target); DISPATCH(); } while (0)
+
+            std::vector<Threaded> code;
+            code.reserve(program.code.size());
+            for (const Instruction &ins: program.code) {
+#if HW3_THREADED_VM
+                code.push_back({handlers[static_cast<std::size_t>(ins.op)], ins.a, ins.b, ins.c});
+#else
+                code.push_back({ins.op, ins.a, ins.b, ins.c});
+#endif
+            }
+
+            const Function &main = program.functions[program.main];
+            std::vector<std::int32_t> stack(std::max<std::size_t>(1024, 2 * main.registers));
+            std::vector<Frame> frames;
+            std::size_t base = 0;
+            std::int32_t *r = stack.data();
+            const Threaded *pc = code.data() + main.entry;
+            DISPATCH();
+
+#if !HW3_THREADED_VM
+            dispatch:
+            switch (pc->op) {
+                case Op::LOADI: goto LOADI;
+                case Op::MOVE: goto MOVE;
+                case Op::ADD: goto ADD;
+                case Op::SUB: goto SUB;
+                case Op::MUL: goto MUL;
+                case Op::DIV: goto DIV;
+                case Op::ADDI: goto ADDI;
+                case Op::TRUNC: goto TRUNC;
+                case Op::JMP: goto JMP;
+                case Op::JT: goto JT;
+                case Op::JF: goto JF;
+                case Op::JEQ: goto JEQ;
+                case Op::JNE: goto JNE;
+                case Op::JLT: goto JLT;
+                case Op::JGT: goto JGT;
+                case Op::JLE: goto JLE;
+                case Op::JGE: goto JGE;
+                case Op::CALL: goto CALL;
+                case Op::RET: goto RET;
+                case Op::RETV: goto RETV;
+                case Op::PRINT: goto PRINT;
+                case Op::PRINTI: goto PRINTI;
+            }
+#endif
+
+            LOADI:
+            r[pc->a] = pc->b;
+            NEXT();
+            MOVE:
+            r[pc->a] = r[pc->b];
+            NEXT();
+            ADD:
+            r[pc->a] = wrap(static_cast<std::uint32_t>(r[pc->b]) + static_cast<std::uint32_t>(r[pc->c]));
+            NEXT();
+            SUB:
+            r[pc->a] = wrap(static_cast<std::uint32_t>(r[pc->b]) - static_cast<std::uint32_t>(r[pc->c]));
+            NEXT();
+            MUL:
+            r[pc->a] = wrap(static_cast<std::uint32_t>(r[pc->b]) * static_cast<std::uint32_t>(r[pc->c]));
+            NEXT();
+            DIV: {
+                std::int32_t divisor = r[pc->c];
+                if (divisor == 0) {
+                    out << "Error division by zero\n";
+                    return executed;
+                }
+                // INT_MIN / -1 wraps like the other operations instead of trapping
+                r[pc->a] = divisor == -1 ? wrap(0u - static_cast<std::uint32_t>(r[pc->b])) : r[pc->b] / divisor;
+                NEXT();
+            }
+            ADDI:
+            r[pc->a] = wrap(static_cast<std::uint32_t>(r[pc->b]) + static_cast<std::uint32_t>(pc->c));
+            NEXT();
+            TRUNC:
+            r[pc->a] = r[pc->b] & 0xff;
+            NEXT();
+            JMP:
+            JUMP(pc->a);
+            JT:
+            if (r[pc->b]) JUMP(pc->a);
+            NEXT();
+            JF:
+            if (!r[pc->b]) JUMP(pc->a);
+            NEXT();
+            JEQ:
+            if (r[pc->b] == r[pc->c]) JUMP(pc->a);
+            NEXT();
+            JNE:
+            if (r[pc->b] != r[pc->c]) JUMP(pc->a);
+            NEXT();
+            JLT:
+            if (r[pc->b] < r[pc->c]) JUMP(pc->a);
+            NEXT();
+            JGT:
+            if (r[pc->b] > r[pc->c]) JUMP(pc->a);
+            NEXT();
+            JLE:
+            if (r[pc->b] <= r[pc->c]) JUMP(pc->a);
+            NEXT();
+            JGE:
+            if (r[pc->b] >= r[pc->c]) JUMP(pc->a);
+            NEXT();
+            CALL: {
+                const Function &callee = program.functions[pc->b];
+                if (frames.size() == MAX_CALL_DEPTH) {
+                    throw std::runtime_error("calls nested too deep in " + callee.name);
+                }
+                frames.push_back({pc + 1, base, pc->a});
+                base += pc->c;
+                if (base + callee.registers > stack.size()) {
+                    stack.resize(2 * (base + callee.registers));
+                }
+                r = stack.data() + base;
+                JUMP(callee.entry);
+            }
+            RET:
+            if (frames.empty()) {
+                return executed;
+            } else {
+                std::int32_t value = r[pc->a];
+                const Frame &frame = frames.back();
+                base = frame.base;
+                r = stack.data() + base;
+                r[frame.dst] = value;
+                pc = frame.ret;
+                frames.pop_back();
+                DISPATCH();
+            }
+            RETV:
+            if (frames.empty()) {
+                return executed;
+            } else {
+                const Frame &frame = frames.back();
+                base = frame.base;
+                r = stack.data() + base;
+                pc = frame.ret;
+                frames.pop_back();
+                DISPATCH();
+            }
+            PRINT: {
+                const std::string &text = program.strings[pc->a];
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                out.put('\n');
+                NEXT();
+            }
+            PRINTI:
+            out << r[pc->a] << '\n';
+            NEXT();
+
+#undef JUMP
+#undef NEXT
+#undef DISPATCH
+        }
+    }
+
+    std::uint64_t run(const Program &program, std::ostream &out, bool count) {
+        return count ? execute<true>(program, out) : execute<false>(program, out);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef VM_HPP
+#define VM_HPP
+
+#include <cstdint>
+#include <ostream>
+
+#include "Bytecode.hpp"
+
+/* Interpreter of the register bytecode
+ * Before running, the code is threaded: each instruction is paired with the address of the code that executes it,
+ * and every handler ends by jumping straight to the next instruction's (computed goto, a GNU extension; other
+ * compilers get one central switch). Frames are windows into one growing register stack.
+ */
+namespace bytecode {
+    // Calls nested deeper than this stop the program
+    constexpr std::size_t MAX_CALL_DEPTH = 1 << 20;
+
+    // Runs program from main, writing what it prints to out. A division by zero prints "Error division by zero"
+    // and ends the program there, as the FanC runtime does. With count, returns the number of instructions
+    // executed, at a small cost per instruction; otherwise returns 0. Throws std::runtime_error if calls nest
+    // deeper than MAX_CALL_DEPTH
+    std::uint64_t run(const Program &program, std::ostream &out, bool count = false);
+}
+
+#endif //VM_HPP
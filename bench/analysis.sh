@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Times a full hw3 run (parse, analysis, scope dump) on a large generated
+# program, optionally against a baseline binary.
+# Usage: bench/analysis.sh [hw3 binary] [baseline hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+BASELINE=$2
+FUNCS=${3:-20000}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+size=$(( $(wc -c < "$WORK_DIR/large.in") / 1024 / 1024 ))
+
+line=$(printf "%-32s %8s ms" "$FUNCS functions (${size} MB)" "$(time_ms "$WORK_DIR/large.in" "$EXECUTABLE")")
+if [ -n "$BASELINE" ]; then
+    line="$line   (baseline $(time_ms "$WORK_DIR/large.in" "$BASELINE") ms)"
+fi
+echo "$line"
@@ -0,0 +1,36 @@
+#!/bin/bash
+
+# Builds each program of bench/vm with --emit-asm, once keeping values in
+# machine registers and once with --emit-asm=stack, the unoptimized baseline
+# that keeps every value in the stack frame, and prints the best wall-clock
+# time of three runs of each next to the bytecode VM's (--run). Needs the
+# GNU assembler and linker (as, ld).
+# Usage: bench/asm.sh [hw3 binary]
+
+EXECUTABLE=${1:-./hw3}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Assembles and links program $1 as executable $2, with --emit-asm$3.
+build() {
+    "$EXECUTABLE" --emit-asm$3 < "$1" > "$WORK_DIR/prog.s" &&
+        as "$WORK_DIR/prog.s" -o "$WORK_DIR/prog.o" &&
+        ld "$WORK_DIR/prog.o" -o "$2"
+}
+
+printf "%-12s %10s %10s %10s\n" "" "registers" "stack" "vm"
+for program in "$BENCH_DIR"/vm/*.in; do
+    build "$program" "$WORK_DIR/registers" "" || exit 1
+    build "$program" "$WORK_DIR/stack" "=stack" || exit 1
+    printf "%-12s %7s ms %7s ms %7s ms\n" "$(basename "$program" .in)" \
+        "$(time_ms /dev/null "$WORK_DIR/registers")" "$(time_ms /dev/null "$WORK_DIR/stack")" \
+        "$(time_ms "$program" "$EXECUTABLE" --run)"
+done
@@ -0,0 +1,38 @@
+#!/bin/bash
+
+# Checking a program from its AST image against checking it from source: the
+# image is written once with --emit-ast, and loading it skips scanning and
+# parsing. Prints the size of each, the time to write the image, and the
+# wall-clock time of a check from each.
+# Usage: bench/ast.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-20000}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Prints the wall-clock time of one run of hw3 with the given arguments on
+# input, in milliseconds, writing its output to output.
+time_ms() {
+    local input=$1 output=$2 start end
+    shift 2
+    start=$(date +%s%N)
+    "$EXECUTABLE" "$@" < "$input" > "$output"
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+emit=$(time_ms "$WORK_DIR/large.in" "$WORK_DIR/large.ast" --emit-ast --scanner=simd)
+echo "$FUNCS functions: $(( $(wc -c < "$WORK_DIR/large.in") / 1024 / 1024 )) MB of source," \
+     "$(( $(wc -c < "$WORK_DIR/large.ast") / 1024 / 1024 )) MB of image"
+printf "%-20s %8d ms\n" "write image" "$emit"
+printf "%-20s %8d ms\n" "check from source" "$(time_ms "$WORK_DIR/large.in" /dev/null --scanner=simd -j 1)"
+printf "%-20s %8d ms\n" "check from image" "$(time_ms "$WORK_DIR/large.ast" /dev/null --ast -j 1)"
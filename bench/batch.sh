@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Compares checking many generated programs one hw3 process at a time with a
+# single "hw3 --batch" run over the same files.
+# Usage: bench/batch.sh [hw3 binary] [files] [functions per file] [jobs]
+
+EXECUTABLE=${1:-./hw3}
+FILES=${2:-200}
+FUNCS=${3:-200}
+JOBS=${4:-0}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/program.in"
+for i in $(seq 1 "$FILES"); do
+    cp "$WORK_DIR/program.in" "$WORK_DIR/p$i.in"
+done
+rm "$WORK_DIR/program.in"
+
+mkdir "$WORK_DIR/serial" "$WORK_DIR/batch"
+
+start=$(date +%s%N)
+for f in "$WORK_DIR"/p*.in; do
+    "$EXECUTABLE" < "$f" > "$WORK_DIR/serial/$(basename "$f" .in).res"
+done
+end=$(date +%s%N)
+serial=$(( (end - start) / 1000000 ))
+
+jobs_arg=()
+if [ "$JOBS" -gt 0 ]; then jobs_arg=(-j "$JOBS"); fi
+start=$(date +%s%N)
+"$EXECUTABLE" --batch "${jobs_arg[@]}" -o "$WORK_DIR/batch" "$WORK_DIR"/p*.in
+end=$(date +%s%N)
+batch=$(( (end - start) / 1000000 ))
+
+if ! diff -r -q "$WORK_DIR/serial" "$WORK_DIR/batch" > /dev/null; then
+    echo "Error: batch output differs from one-process-per-file output"
+    exit 1
+fi
+
+printf "%-32s %8s ms\n" "$FILES files, one process each" "$serial"
+printf "%-32s %8s ms\n" "$FILES files, --batch" "$batch"
@@ -0,0 +1,45 @@
+#!/bin/bash
+
+# Ahead-of-time builds through C: for each program of bench/vm, and for a
+# large generated one (see gen-large.sh) rewritten so that its functions call
+# f0 instead of the one before and main calls each once, so that its build
+# dominates, prints the best wall-clock time of three runs of writing the C
+# (--emit-c, which includes the check), compiling it with the system C
+# compiler at -O0 and at -O2, and running each build, next to checking and
+# running the program on the bytecode VM (--run).
+# Usage: bench/c.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-500}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+CC=${CC:-cc}
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" | sed -e 's/acc + f[0-9]*(acc,/acc + f0(acc,/' -e '/^void main() {$/,$d' \
+    > "$WORK_DIR/large.in"
+awk -v n="$FUNCS" 'BEGIN {
+    printf "void main() {\n    int sum = 0;\n"
+    for (i = 0; i < n; i++) printf "    sum = sum + f%d(%d, 2b);\n", i, i
+    printf "    printi(sum);\n}\n"
+}' >> "$WORK_DIR/large.in"
+
+printf "%-12s %10s %10s %10s %10s %10s %10s\n" "" "emit" "cc -O0" "run -O0" "cc -O2" "run -O2" "vm"
+for program in "$BENCH_DIR"/vm/*.in "$WORK_DIR/large.in"; do
+    "$EXECUTABLE" --emit-c < "$program" > "$WORK_DIR/prog.c" || exit 1
+    emit=$(time_ms "$program" "$EXECUTABLE" --emit-c)
+    compile0=$(time_ms /dev/null "$CC" -O0 "$WORK_DIR/prog.c" -o "$WORK_DIR/O0") || exit 1
+    compile2=$(time_ms /dev/null "$CC" -O2 "$WORK_DIR/prog.c" -o "$WORK_DIR/O2") || exit 1
+    name=$(basename "$program" .in)
+    [ "$name" = large ] && name="large/$FUNCS"
+    printf "%-12s %7s ms %7s ms %7s ms %7s ms %7s ms %7s ms\n" "$name" "$emit" "$compile0" \
+        "$(time_ms /dev/null "$WORK_DIR/O0")" "$compile2" "$(time_ms /dev/null "$WORK_DIR/O2")" \
+        "$(time_ms "$program" "$EXECUTABLE" --run)"
+done
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+# Incremental re-analysis with the analysis cache: checks a large program
+# with an empty cache, again unchanged, and then after a one-line edit to a
+# function in the middle, which should cost about as much as the unchanged
+# run. Prints the wall-clock time of each, with a full check for reference.
+# Usage: bench/cache.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-40000}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+# A statement of f<FUNCS/2> that is not in any other function
+awk -v f="int f$(( FUNCS / 2 ))(" '
+    index($0, f) == 1 { print; print "    int edited = 1;"; next }
+    { print }' "$WORK_DIR/large.in" > "$WORK_DIR/edited.in"
+bytes=$(wc -c < "$WORK_DIR/large.in")
+
+# Prints the wall-clock time of one run of hw3 with the given arguments on
+# input, in milliseconds.
+time_ms() {
+    local input=$1 start end
+    shift
+    start=$(date +%s%N)
+    "$EXECUTABLE" "$@" < "$input" > /dev/null
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+report() {
+    printf "%-20s %8d ms\n" "$1" "$(time_ms "${@:2}")"
+}
+
+echo "$FUNCS functions ($(( bytes / 1024 / 1024 )) MB)"
+report "full" "$WORK_DIR/large.in" --scanner=simd -j 1
+report "cache, cold" "$WORK_DIR/large.in" --cache="$WORK_DIR/cache"
+report "cache, unchanged" "$WORK_DIR/large.in" --cache="$WORK_DIR/cache"
+report "cache, one edit" "$WORK_DIR/edited.in" --cache="$WORK_DIR/cache"
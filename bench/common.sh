@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Helpers shared by the bench scripts, which source this file.
+
+# Prints the best of three wall-clock runs in milliseconds of the command
+# after $1, reading $1.
+time_ms() {
+    local input=$1 best= start end t
+    shift
+    for _ in 1 2 3; do
+        start=$(date +%s%N)
+        "$@" < "$input" > /dev/null
+        end=$(date +%s%N)
+        t=$(( (end - start) / 1000000 ))
+        if [ -z "$best" ] || [ "$t" -lt "$best" ]; then best=$t; fi
+    done
+    echo "$best"
+}
@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# Constant folding: for each program of bench/vm and a large generated one
+# (see gen-large.sh), prints the nodes of the tree before and after folding,
+# the time folding takes, and the time lowering to bytecode takes with and
+# without it (--no-fold), the best of three runs of --bytecode --stats=json.
+# Usage: bench/fold.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-20000}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+
+# Prints the total of the node counts in the JSON object named $1 of the
+# report on stdin.
+nodes() {
+    grep -o "\"$1\":{[^}]*}" | grep -o ':[0-9]*' | tr -d : | awk '{ n += $1 } END { print n + 0 }'
+}
+
+# Prints the wall-clock milliseconds of phase $1 in the report on stdin.
+phase_ms() {
+    grep -o "\"$1\":{\"wall_ms\":[0-9.]*" | sed 's/.*://'
+}
+
+# Prints the least of the numbers on stdin.
+least() {
+    sort -g | head -n 1
+}
+
+printf "%-14s %10s %10s %10s %10s %10s\n" "" "nodes" "folded" "fold" "lower" "unfolded"
+for program in "$BENCH_DIR"/vm/*.in "$WORK_DIR/large.in"; do
+    "$EXECUTABLE" --bytecode --stats=json < "$program" 2> "$WORK_DIR/report" > /dev/null || exit 1
+    before=$(nodes nodes < "$WORK_DIR/report")
+    after=$(nodes folded_nodes < "$WORK_DIR/report")
+    fold=$(for _ in 1 2 3; do
+        "$EXECUTABLE" --bytecode --stats=json < "$program" 2>&1 > /dev/null | phase_ms fold
+    done | least)
+    lower=$(for _ in 1 2 3; do
+        "$EXECUTABLE" --bytecode --stats=json < "$program" 2>&1 > /dev/null | phase_ms lower
+    done | least)
+    unfolded=$(for _ in 1 2 3; do
+        "$EXECUTABLE" --bytecode --no-fold --stats=json < "$program" 2>&1 > /dev/null | phase_ms lower
+    done | least)
+    name=$(basename "$program" .in)
+    [ "$name" = large ] && name="large/$FUNCS"
+    printf "%-14s %10s %10s %7s ms %7s ms %7s ms\n" "$name" "$before" "$after" "$fold" "$lower" "$unfolded"
+done
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Writes a large, semantically valid FanC program to stdout.
+# Usage: bench/gen-large.sh [functions] [statements per function]
+
+FUNCS=${1:-20000}
+STMTS=${2:-40}
+
+awk -v n="$FUNCS" -v m="$STMTS" 'BEGIN {
+    printf "int f0(int a, byte b) {\n    return a + b;\n}\n"
+    for (i = 1; i < n; i++) {
+        printf "int f%d(int a, byte b) {\n", i
+        printf "    int acc = 0;\n    byte k = 3b;\n    bool flag = a > 0 and not (b == 0b);\n"
+        for (j = 0; j < m; j++) {
+            s = j % 6
+            if (s == 0) printf "    acc = acc + (a * %d - b) / (k + 1);\n", j + 1
+            else if (s == 1) printf "    if (flag or acc < %d) {\n        int t%d = acc * 2;\n        acc = t%d - 1;\n    } else {\n        acc = acc + 1;\n    }\n", j, j, j
+            else if (s == 2) printf "    while (k < 10b) {\n        k = k + 1b;\n        if (k == 7b) break;\n    }\n"
+            else if (s == 3) printf "    acc = acc + f%d(acc, (byte)%d);\n", i - 1, j % 200
+            else if (s == 4) printf "    // comment %d: acc = acc + 1;\n    flag = not flag and (acc >= a or b <= k);\n", j
+            else printf "    {\n        byte local%d = (byte)(acc + %d);\n        acc = acc - local%d;\n    }\n", j, j, j
+        }
+        printf "    return acc;\n}\n"
+    }
+    printf "void main() {\n    printi(f%d(1, 2b));\n    print(\"done\");\n}\n", n - 1
+}'
@@ -0,0 +1,55 @@
+#!/bin/bash
+
+# Lazy against full parsing: with --lazy only the function headers are parsed
+# up front, and each body is parsed when the analysis reaches it and dropped
+# right after, so at most one body tree is alive at a time. Prints the best of
+# three runs in milliseconds and the peak resident memory of the last one, for
+# a valid program and for one with a semantic error in its first function.
+# Usage: bench/lazy.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-40000}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+sed '2s/return a + b;/return a + undefined;/' "$WORK_DIR/large.in" > "$WORK_DIR/error.in"
+bytes=$(wc -c < "$WORK_DIR/large.in")
+
+# Runs hw3 with the given arguments on input and prints its peak resident set
+# in kB, sampled from /proc while it runs.
+peak_kb() {
+    local input=$1 pid peak=0 hwm
+    shift
+    "$EXECUTABLE" "$@" < "$input" > /dev/null &
+    pid=$!
+    while hwm=$(awk '/^VmHWM/ { print $2 }' "/proc/$pid/status" 2>/dev/null) && [ -n "$hwm" ]; do
+        peak=$hwm
+        sleep 0.01
+    done
+    wait "$pid"
+    echo "$peak"
+}
+
+report() {
+    local label=$1 input=$2 ms kb
+    shift 2
+    ms=$(time_ms "$input" "$EXECUTABLE" "$@")
+    kb=$(peak_kb "$input" "$@")
+    printf "%-20s %8d ms %8d MB peak\n" "$label" "$ms" $(( kb / 1024 ))
+}
+
+echo "$FUNCS functions ($(( bytes / 1024 / 1024 )) MB)"
+for input in large error; do
+    echo "$input.in:"
+    report "  full" "$WORK_DIR/$input.in" --scanner=simd -j 1
+    report "  lazy" "$WORK_DIR/$input.in" --lazy
+done
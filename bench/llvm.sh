@@ -0,0 +1,56 @@
+#!/bin/bash
+
+# Builds each program of bench/vm with --emit-llvm, once unoptimized (-O0)
+# and once optimized (-O2), and prints the best wall-clock time of three runs
+# of each next to the register build of --emit-asm and the bytecode VM
+# (--run). Compiles with clang where it is installed, otherwise with LLVM's
+# opt and llc and the system C compiler to link.
+# Usage: bench/llvm.sh [hw3 binary]
+
+EXECUTABLE=${1:-./hw3}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# LLVM before 15 reads the opaque pointers of the module only when asked to
+OPAQUE=
+if command -v llc > /dev/null && llc --version | grep -q 'LLVM version 1[0-4]\.'; then
+    OPAQUE=-opaque-pointers
+fi
+
+# Compiles program $1 as executable $2 with --emit-llvm at optimization
+# level $3.
+build_llvm() {
+    "$EXECUTABLE" --emit-llvm < "$1" > "$WORK_DIR/prog.ll" || return 1
+    if command -v clang > /dev/null; then
+        clang -O$3 -Wno-override-module "$WORK_DIR/prog.ll" -o "$2"
+    else
+        opt $OPAQUE -O$3 "$WORK_DIR/prog.ll" -o "$WORK_DIR/prog.bc" &&
+            llc $OPAQUE -O$3 -relocation-model=pic -filetype=obj "$WORK_DIR/prog.bc" -o "$WORK_DIR/prog.o" &&
+            cc "$WORK_DIR/prog.o" -o "$2"
+    fi
+}
+
+# Assembles and links program $1 as executable $2 with --emit-asm.
+build_asm() {
+    "$EXECUTABLE" --emit-asm < "$1" > "$WORK_DIR/prog.s" &&
+        as "$WORK_DIR/prog.s" -o "$WORK_DIR/prog.o" &&
+        ld "$WORK_DIR/prog.o" -o "$2"
+}
+
+printf "%-12s %10s %10s %10s %10s\n" "" "llvm -O0" "llvm -O2" "asm" "vm"
+for program in "$BENCH_DIR"/vm/*.in; do
+    build_llvm "$program" "$WORK_DIR/O0" 0 || exit 1
+    build_llvm "$program" "$WORK_DIR/O2" 2 || exit 1
+    build_asm "$program" "$WORK_DIR/asm" || exit 1
+    printf "%-12s %7s ms %7s ms %7s ms %7s ms\n" "$(basename "$program" .in)" \
+        "$(time_ms /dev/null "$WORK_DIR/O0")" "$(time_ms /dev/null "$WORK_DIR/O2")" \
+        "$(time_ms /dev/null "$WORK_DIR/asm")" "$(time_ms "$program" "$EXECUTABLE" --run)"
+done
@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Measures how fast hw3 produces its scope dump: the output of a large valid
+# program is written to a file, and the rate is its size over the wall time of
+# the whole run (parse and analysis included), best of three.
+# Usage: bench/output.sh [hw3 binary] [baseline hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+BASELINE=$2
+FUNCS=${3:-20000}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+
+# Prints "<output MB> <best ms> <MB/s>" for one binary.
+measure() {
+    local bin=$1 best= start end t bytes
+    for _ in 1 2 3; do
+        start=$(date +%s%N)
+        "$bin" < "$WORK_DIR/large.in" > "$WORK_DIR/large.res"
+        end=$(date +%s%N)
+        t=$(( (end - start) / 1000000 ))
+        if [ -z "$best" ] || [ "$t" -lt "$best" ]; then best=$t; fi
+    done
+    bytes=$(wc -c < "$WORK_DIR/large.res")
+    awk -v b="$bytes" -v t="$best" 'BEGIN { printf "%.1f %d %.1f", b / 1048576, t, b / 1048576 / (t / 1000) }'
+}
+
+read -r mb ms rate <<< "$(measure "$EXECUTABLE")"
+line=$(printf "%-32s %8s ms %8s MB/s" "$FUNCS functions (${mb} MB out)" "$ms" "$rate")
+if [ -n "$BASELINE" ]; then
+    read -r _ bms brate <<< "$(measure "$BASELINE")"
+    line="$line   (baseline $bms ms, $brate MB/s)"
+fi
+echo "$line"
@@ -0,0 +1,41 @@
+#!/bin/bash
+
+# Pipelined against pull-based scanning: with --pipeline the scanner runs on
+# a lexer thread that feeds the parser through a bounded token ring, instead
+# of being called by the parser for each token. Prints the best of three
+# runs in milliseconds and MB/s for only lexing (--lex, which measures the
+# cost of the ring) and for a whole compile, with each scanner backend.
+# Usage: bench/pipeline.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-40000}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+bytes=$(wc -c < "$WORK_DIR/large.in")
+
+report() {
+    local label=$1 ms
+    shift
+    ms=$(time_ms "$WORK_DIR/large.in" "$EXECUTABLE" "$@")
+    awk -v label="$label" -v b="$bytes" -v t="$ms" \
+        'BEGIN { printf "%-24s %8d ms %8.1f MB/s\n", label, t, b / 1048576 / (t > 0 ? t / 1000 : 0.001) }'
+}
+
+echo "$FUNCS functions ($(( bytes / 1024 / 1024 )) MB), $(nproc) CPUs"
+for mode in --lex ""; do
+    echo "${mode:-compile}:"
+    for scanner in flex simd; do
+        report "  $scanner pull" $mode --scanner=$scanner -j 1
+        report "  $scanner pipeline" $mode --scanner=$scanner --pipeline -j 1
+    done
+done
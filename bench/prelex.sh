@@ -0,0 +1,43 @@
+#!/bin/bash
+
+# Pre-lexing throughput: hw3 --lex --scanner=prelex splits the generated
+# program into newline-aligned chunks and scans them on -j threads into a
+# token array. Prints MB/s for the streaming SIMD scanner and for pre-lexing
+# at each thread count, then the same for a whole compile, best of three runs.
+# Usage: bench/prelex.sh [hw3 binary] [functions] [max jobs]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-40000}
+MAX_JOBS=${3:-$(nproc)}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+bytes=$(wc -c < "$WORK_DIR/large.in")
+
+report() {
+    local label=$1 ms
+    shift
+    ms=$(time_ms "$WORK_DIR/large.in" "$EXECUTABLE" "$@")
+    awk -v label="$label" -v b="$bytes" -v t="$ms" \
+        'BEGIN { printf "%-20s %8d ms %8.1f MB/s\n", label, t, b / 1048576 / (t > 0 ? t / 1000 : 0.001) }'
+}
+
+echo "$FUNCS functions ($(( bytes / 1024 / 1024 )) MB)"
+for mode in --lex ""; do
+    echo "${mode:-compile}:"
+    report "  simd" $mode --scanner=simd -j 1
+    jobs=1
+    while [ "$jobs" -le "$MAX_JOBS" ]; do
+        report "  prelex -j $jobs" $mode --scanner=prelex -j "$jobs"
+        jobs=$(( jobs * 2 ))
+    done
+done
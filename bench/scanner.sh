@@ -0,0 +1,35 @@
+#!/bin/bash
+
+# Scanner throughput in MB/s: hw3 --lex only tokenizes its input, so the
+# rate is the generated program's size over the best of three runs, for the
+# flex scanner and the SIMD scanner at each kernel width.
+# Usage: bench/scanner.sh [hw3 binary] [functions]
+
+EXECUTABLE=${1:-./hw3}
+FUNCS=${2:-20000}
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+"$BENCH_DIR/gen-large.sh" "$FUNCS" > "$WORK_DIR/large.in"
+bytes=$(wc -c < "$WORK_DIR/large.in")
+
+report() {
+    local ms
+    ms=$(time_ms "$WORK_DIR/large.in" env "$2" "$EXECUTABLE" --lex "$3")
+    awk -v label="$1" -v b="$bytes" -v t="$ms" \
+        'BEGIN { printf "%-16s %8d ms %8.1f MB/s\n", label, t, b / 1048576 / (t > 0 ? t / 1000 : 0.001) }'
+}
+
+echo "$FUNCS functions ($(( bytes / 1024 / 1024 )) MB)"
+report "flex" HW3_SIMD= --scanner=flex
+report "simd (scalar)" HW3_SIMD=scalar --scanner=simd
+report "simd (sse2)" HW3_SIMD=sse2 --scanner=simd
+report "simd (avx2)" HW3_SIMD=avx2 --scanner=simd
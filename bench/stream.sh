@@ -0,0 +1,53 @@
+#!/bin/bash
+
+# Streaming against full analysis as programs grow: with --stream each
+# function is analyzed as soon as it is parsed and then freed, and its scopes
+# go to a temporary file, so peak memory should not follow the length of the
+# program. Prints the wall-clock time and the peak resident memory of one run
+# of each, for programs of doubling size.
+# Usage: bench/stream.sh [hw3 binary] [max functions]
+
+EXECUTABLE=${1:-./hw3}
+MAX_FUNCS=${2:-40000}
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Runs hw3 with the given arguments on input and prints its wall-clock time
+# in milliseconds and its peak resident set in kB, sampled from /proc while it
+# runs.
+measure() {
+    local input=$1 pid peak=0 hwm start end
+    shift
+    start=$(date +%s%N)
+    "$EXECUTABLE" "$@" < "$input" > /dev/null &
+    pid=$!
+    while hwm=$(awk '/^VmHWM/ { print $2 }' "/proc/$pid/status" 2>/dev/null) && [ -n "$hwm" ]; do
+        peak=$hwm
+        sleep 0.01
+    done
+    wait "$pid"
+    end=$(date +%s%N)
+    echo "$(( (end - start) / 1000000 )) $peak"
+}
+
+funcs=$(( MAX_FUNCS / 8 ))
+while [ "$funcs" -le "$MAX_FUNCS" ]; do
+    "$BENCH_DIR/gen-large.sh" "$funcs" > "$WORK_DIR/large.in"
+    echo "$funcs functions ($(( $(wc -c < "$WORK_DIR/large.in") / 1024 / 1024 )) MB):"
+    for mode in full stream; do
+        if [ "$mode" = full ]; then
+            read -r ms kb < <(measure "$WORK_DIR/large.in" --scanner=simd -j 1)
+        else
+            read -r ms kb < <(measure "$WORK_DIR/large.in" --stream)
+        fi
+        printf "  %-18s %8d ms %8d MB peak\n" "$mode" "$ms" $(( kb / 1024 ))
+    done
+    funcs=$(( funcs * 2 ))
+done
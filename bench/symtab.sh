@@ -0,0 +1,58 @@
+#!/bin/bash
+
+# Symbol-table microbenchmark: times hw3 on generated programs that stress
+# scope depth and scope width.
+# Usage: bench/symtab.sh [hw3 binary] [baseline hw3 binary]
+
+EXECUTABLE=${1:-./hw3}
+BASELINE=$2
+BENCH_DIR=$(dirname "$0")
+. "$BENCH_DIR/common.sh"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Deep nesting: $1 nested blocks, each declaring a local; the innermost
+# block reads the outermost local and calls a function $2 times.
+deep_nesting() {
+    awk -v d="$1" -v m="$2" 'BEGIN {
+        printf "int id(int x) {\n    return x;\n}\n"
+        printf "void main() {\n"
+        for (i = 0; i < d; i++) printf "{\nint v%d = %d;\n", i, i
+        for (i = 0; i < m; i++) printf "v0 = id(v0 + 1);\n"
+        for (i = 0; i < d; i++) printf "}\n"
+        printf "}\n"
+    }'
+}
+
+# Many locals: one function declaring $1 locals, then $2 blocks that each
+# open a scope and use a few of them.
+many_locals() {
+    awk -v n="$1" -v m="$2" 'BEGIN {
+        printf "void main() {\n"
+        for (i = 0; i < n; i++) printf "    int v%d = %d;\n", i, i
+        for (i = 0; i < m; i++) printf "    if (v%d < v%d) { int t%d = v%d; }\n", i % n, (i * 7) % n, i, (i * 13) % n
+        printf "}\n"
+    }'
+}
+
+report() {
+    local label=$1 input=$2
+    local line
+    line=$(printf "%-32s %8s ms" "$label" "$(time_ms "$input" "$EXECUTABLE")")
+    if [ -n "$BASELINE" ]; then
+        line="$line   (baseline $(time_ms "$input" "$BASELINE") ms)"
+    fi
+    echo "$line"
+}
+
+deep_nesting 2000 20000 > "$WORK_DIR/deep.in"
+many_locals 50000 50000 > "$WORK_DIR/wide.in"
+
+report "deep nesting (2000 levels)" "$WORK_DIR/deep.in"
+report "many locals (50000 + blocks)" "$WORK_DIR/wide.in"
@@ -0,0 +1,42 @@
+#!/bin/bash
+
+# Times --run on each program of bench/vm and prints the instructions the VM
+# executed, its best run time of three and the rate in millions of
+# instructions per second, optionally against a baseline binary.
+# Usage: bench/vm.sh [hw3 binary] [baseline hw3 binary]
+
+EXECUTABLE=${1:-./hw3}
+BASELINE=$2
+BENCH_DIR=$(dirname "$0")
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -x "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Prints the instructions and the best of three run times in milliseconds
+# of program $2 on binary $1, from the run phase of --stats=json.
+measure() {
+    local bin=$1 program=$2 best= count t
+    for _ in 1 2 3; do
+        "$bin" --run --stats=json < "$program" > /dev/null 2> "$WORK_DIR/stats.json"
+        count=$(grep -o '"vm":{"instructions":[0-9]*' "$WORK_DIR/stats.json" | grep -o '[0-9]*$')
+        t=$(grep -o '"run":{"wall_ms":[0-9.]*' "$WORK_DIR/stats.json" | grep -o '[0-9.]*$')
+        if [ -z "$best" ] || awk -v t="$t" -v b="$best" 'BEGIN { exit !(t < b) }'; then best=$t; fi
+    done
+    echo "$count $best"
+}
+
+for program in "$BENCH_DIR"/vm/*.in; do
+    read -r count ms <<< "$(measure "$EXECUTABLE" "$program")"
+    line=$(awk -v name="$(basename "$program" .in)" -v n="$count" -v ms="$ms" \
+        'BEGIN { printf "%-12s %12d instructions %10.1f ms %8.0f M/s", name, n, ms, n / ms / 1000 }')
+    if [ -n "$BASELINE" ]; then
+        read -r count ms <<< "$(measure "$BASELINE" "$program")"
+        line="$line   (baseline $ms ms)"
+    fi
+    echo "$line"
+done
@@ -0,0 +1,546 @@
+#include "driver.hpp"
+#include "AnalysisCache.hpp"
+#include "AstImage.hpp"
+#include "Bytecode.hpp"
+#include "CSource.hpp"
+#include "Folding.hpp"
+#include "frontend.hpp"
+#include "LlvmIr.hpp"
+#include "output.hpp"
+#include "SemanticParser.hpp"
+#include "Trace.hpp"
+#include "Vm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+bool parseCount(const std::string &text, unsigned &value) {
+    // strtoul alone would skip leading spaces and wrap a minus sign around
+    if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    unsigned long parsed = std::strtoul(text.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE || parsed > UINT_MAX) {
+        return false;
+    }
+    value = static_cast<unsigned>(parsed);
+    return true;
+}
+
+OptionStatus parseCompileOption(const std::string &arg, CompileOptions &options) {
+    if (arg == "--scanner=flex") {
+        options.scanner = ScannerKind::Flex;
+    } else if (arg == "--scanner=simd") {
+        options.scanner = ScannerKind::Simd;
+    } else if (arg == "--scanner=prelex") {
+        options.scanner = ScannerKind::Prelex;
+    } else if (arg == "--pipeline") {
+        options.pipeline = true;
+    } else if (arg == "--lazy") {
+        options.lazy = true;
+    } else if (arg == "--stream") {
+        options.stream = true;
+    } else if (arg == "--ast") {
+        options.astInput = true;
+    } else if (arg == "--run") {
+        options.run = true;
+    } else if (arg == "--bytecode") {
+        options.listBytecode = true;
+    } else if (arg == "--emit-asm") {
+        options.emitAsm = AsmOutput::Registers;
+    } else if (arg == "--emit-asm=stack") {
+        options.emitAsm = AsmOutput::Stack;
+    } else if (arg == "--emit-llvm") {
+        options.emitLlvm = true;
+    } else if (arg == "--emit-c") {
+        options.emitC = true;
+    } else if (arg == "--no-fold") {
+        options.fold = false;
+    } else if (arg == "--stats") {
+        options.stats = StatsFormat::Text;
+    } else if (arg == "--stats=json") {
+        options.stats = StatsFormat::Json;
+    } else if (arg.compare(0, 8, "--cache=") == 0 && arg.size() > 8) {
+        options.cacheDir = arg.substr(8);
+    } else if (arg.compare(0, 8, "--trace=") == 0 && arg.size() > 8) {
+        options.tracePath = arg.substr(8);
+    } else if (arg.compare(0, 15, "--trace-scopes=") == 0 && arg.size() > 15) {
+        if (!parseCount(arg.substr(15), options.traceScopeMicros)) {
+            std::cerr << "hw3: --trace-scopes needs a number of microseconds" << std::endl;
+            return OptionStatus::BadValue;
+        }
+    } else {
+        return OptionStatus::Unknown;
+    }
+    return OptionStatus::Applied;
+}
+
+namespace {
+    // Records the bytes the arenas of program hold in stats, if any. Parsing on demand rewinds them after each
+    // function, so this is called before every rewind as well as at the end
+    void countArenas(const ParsedProgram &program, Stats *stats) {
+        if (stats) {
+            stats->countArenas(program.arena, program.tokenArena);
+        }
+    }
+
+    // Bodies skipped by parseHeaders, each parsed when pass 2 reaches it and dropped from the arenas right after
+    class BodiesOnDemand : public LazyBodies {
+    public:
+        BodiesOnDemand(ParsedProgram &program, Stats *stats) : program(program), stats(stats) {}
+
+        ast::Statements *parse(std::size_t index) override {
+            nodesMark = program.arena.mark();
+            tokensMark = program.tokenArena.mark();
+            try {
+                ast::Statements *body = parseBody(program, index);
+                parsed = index + 1;
+                return body;
+            } catch (const output::Aborted &) {
+                failed = true;
+                throw;
+            }
+        }
+
+        void release(std::size_t) override {
+            countArenas(program, stats);
+            program.arena.rewind(nodesMark);
+            program.tokenArena.rewind(tokensMark);
+        }
+
+        std::string_view text(std::size_t index) override {
+            return {program.bodies[index].begin, program.bodies[index].length};
+        }
+
+        // Number of bodies parsed without error, in order
+        std::size_t parsed = 0;
+        // A body had a syntax or lexical error
+        bool failed = false;
+
+    private:
+        ParsedProgram &program;
+        Stats *stats;
+        ast::Arena::Mark nodesMark{};
+        ast::Arena::Mark tokensMark{};
+    };
+
+    // Counts the work of an analyzer's symbol table if there are stats, and adds it to them when the check ends,
+    // however it ends
+    class CountSymbols {
+    public:
+        CountSymbols(SemanticParser &visitor, Stats *stats) : visitor(visitor), stats(stats) {
+            if (stats) {
+                visitor.countSymbols();
+            }
+        }
+
+        CountSymbols(const CountSymbols &) = delete;
+
+        CountSymbols &operator=(const CountSymbols &) = delete;
+
+        ~CountSymbols() {
+            if (stats) {
+                stats->addSymbols(visitor.symbolCounters());
+            }
+        }
+
+    private:
+        const SemanticParser &visitor;
+        Stats *stats;
+    };
+
+    // Records the bytes of a program's arenas in stats when the check ends, however it ends
+    class CountArenas {
+    public:
+        CountArenas(const ParsedProgram &program, Stats *stats) : program(program), stats(stats) {}
+
+        CountArenas(const CountArenas &) = delete;
+
+        CountArenas &operator=(const CountArenas &) = delete;
+
+        ~CountArenas() { countArenas(program, stats); }
+
+    private:
+        const ParsedProgram &program;
+        Stats *stats;
+    };
+
+    void render(const SemanticParser &visitor, Stats *stats) {
+        Stats::Timer timer(stats, Stats::RENDER);
+        trace::Span span("render");
+        visitor.print();
+    }
+
+    // Lowers the checked program and runs it, lists its bytecode or writes it as assembly, LLVM IR or C, as options
+    // ask, on the current output destination
+    void execute(ast::Funcs &funcs, const ast::Interner &names, const CompileOptions &options, Stats *stats) {
+        if (options.emitLlvm) {
+            // Written from the tree: LLVM does its own lowering
+            Stats::Timer timer(stats, Stats::LOWER);
+            trace::Span span("emit llvm");
+            llvm_ir::emit(funcs, names, output::Destination::stream());
+            return;
+        }
+        if (options.emitC) {
+            Stats::Timer timer(stats, Stats::LOWER);
+            trace::Span span("emit c");
+            c_source::emit(funcs, names, output::Destination::stream());
+            return;
+        }
+        bytecode::Program program;
+        {
+            Stats::Timer timer(stats, Stats::LOWER);
+            trace::Span span("lower");
+            program = bytecode::lower(funcs, names);
+        }
+        std::ostream &out = output::Destination::stream();
+        if (options.listBytecode) {
+            program.disassemble(out);
+            return;
+        }
+        if (options.emitAsm != AsmOutput::None) {
+            Stats::Timer timer(stats, Stats::LOWER);
+            trace::Span span("emit asm");
+            assembly::emit(program, out, options.emitAsm);
+            return;
+        }
+        Stats::Timer timer(stats, Stats::RUN);
+        trace::Span span("run");
+        std::uint64_t executed = bytecode::run(program, out, stats != nullptr);
+        if (stats) {
+            stats->addInstructions(executed);
+        }
+    }
+
+    // Checks program parsing function bodies only as pass 2 reaches them. Errors are held back until the bodies
+    // not parsed yet are known to be free of syntax and lexical errors, since a full parse reads the whole program
+    // before the analysis starts: any such error wins over a semantic error, and an earlier one over a later one.
+    // With a cache, bodies whose analysis is in it are not parsed at all: they parsed cleanly when it was stored.
+    void compileLazy(ParsedProgram &program, const AnalysisCache *cache, Stats *stats) {
+        BodiesOnDemand bodies(program, stats);
+        CountArenas arenas(program, stats);
+        SemanticParser visitor(program.names);
+        visitor.setLazyBodies(&bodies);
+        visitor.setCache(cache);
+        visitor.setStats(stats);
+        CountSymbols counted(visitor, stats);
+        std::ostringstream held;
+        try {
+            output::Destination hold(held, &program.names);
+            {
+                Stats::Timer timer(stats, Stats::PARSE);
+                parseHeaders(program);
+            }
+            if (stats) {
+                stats->countNodes(*program.funcs);
+            }
+            visitor.visit(*program.funcs);
+        } catch (const output::Aborted &) {
+            if (!bodies.failed) {
+                for (std::size_t i = bodies.parsed; i < program.bodies.size(); ++i) {
+                    bodies.parse(i);
+                    bodies.release(i);
+                }
+            }
+            output::Destination::stream() << held.str();
+            throw;
+        }
+        render(visitor, stats);
+    }
+
+    // Hands every function to the analyzer as soon as it is parsed
+    class AnalyzeAsParsed : public FunctionSink {
+    public:
+        AnalyzeAsParsed(const ParsedProgram &program, SemanticParser &visitor, Stats *stats)
+                : program(program), visitor(visitor), stats(stats) {}
+
+        void function(std::size_t, ast::FuncDecl &decl) override {
+            if (stats) {
+                stats->countNodes(decl);
+            }
+            countArenas(program, stats);
+            visitor.streamFunction(decl);
+        }
+
+    private:
+        const ParsedProgram &program;
+        SemanticParser &visitor;
+        Stats *stats;
+    };
+
+    // Functions recorded by parseStreaming, parsed again one at a time and dropped from the arenas right after
+    class FunctionsOnDemand : public StreamedFunctions {
+    public:
+        FunctionsOnDemand(ParsedProgram &program, Stats *stats) : program(program), stats(stats) {}
+
+        ast::FuncDecl *parse(std::size_t index) override {
+            nodesMark = program.arena.mark();
+            tokensMark = program.tokenArena.mark();
+            return parseFunction(program, index);
+        }
+
+        void release(std::size_t) override {
+            countArenas(program, stats);
+            program.arena.rewind(nodesMark);
+            program.tokenArena.rewind(tokensMark);
+        }
+
+    private:
+        ParsedProgram &program;
+        Stats *stats;
+        ast::Arena::Mark nodesMark{};
+        ast::Arena::Mark tokensMark{};
+    };
+
+    // Checks program analyzing each function as soon as it is parsed, so that only one is ever in memory. A syntax
+    // or lexical error is reported by the parse as usual; semantic errors only once the whole program is parsed.
+    // The parse phase of stats includes the analysis, and pass 2 is the analysis finishStream repeats
+    void compileStreaming(ParsedProgram &program, Stats *stats) {
+        SemanticParser visitor(program.names);
+        CountSymbols counted(visitor, stats);
+        CountArenas arenas(program, stats);
+        AnalyzeAsParsed sink(program, visitor, stats);
+        {
+            Stats::Timer timer(stats, Stats::PARSE);
+            parseStreaming(program, sink);
+        }
+        {
+            Stats::Timer timer(stats, Stats::PASS2);
+            FunctionsOnDemand functions(program, stats);
+            visitor.finishStream(functions);
+        }
+        render(visitor, stats);
+    }
+}
+
+bool compile(std::FILE *input, std::ostream &out, const CompileOptions &options, Stats *stats) {
+    Source source = Source::read(input);
+    output::Destination destination(out);
+    try {
+        bool executes = options.run || options.listBytecode || options.emitAsm != AsmOutput::None || options.emitLlvm ||
+                        options.emitC;
+        bool wholeTree = options.astInput || executes;
+        if (options.stream && !wholeTree) {
+            ParsedProgram program;
+            program.source = std::move(source);
+            destination.setNames(&program.names);
+            compileStreaming(program, stats);
+            return true;
+        }
+        if ((options.lazy || !options.cacheDir.empty()) && !wholeTree) {
+            ParsedProgram program;
+            program.source = std::move(source);
+            destination.setNames(&program.names);
+            std::optional<AnalysisCache> cache;
+            if (!options.cacheDir.empty()) {
+                cache.emplace(options.cacheDir);
+            }
+            compileLazy(program, cache ? &*cache : nullptr, stats);
+            return true;
+        }
+
+        std::unique_ptr<ParsedProgram> program;
+        {
+            Stats::Timer timer(stats, Stats::PARSE);
+            program = options.astInput
+                      ? loadAstImage(std::move(source))
+                      : parseProgram(std::move(source), options.scanner, options.jobs, options.pipeline);
+        }
+        destination.setNames(&program->names);
+        if (stats) {
+            stats->countNodes(*program->funcs);
+        }
+
+        CountArenas arenas(*program, stats);
+        SemanticParser visitor(program->names, options.jobs);
+        visitor.setStats(stats);
+        CountSymbols counted(visitor, stats);
+        visitor.visit(*program->funcs);
+        if (executes) {
+            if (options.fold) {
+                folding::Counters counters{};
+                {
+                    Stats::Timer timer(stats, Stats::FOLD);
+                    trace::Span span("fold");
+                    counters = folding::fold(*program->funcs, program->arena);
+                }
+                if (stats) {
+                    stats->countFolded(*program->funcs, counters);
+                }
+            }
+            execute(*program->funcs, program->names, options, stats);
+        } else {
+            render(visitor, stats);
+        }
+    } catch (const output::Aborted &) {
+        // The error message is already written; like the single-file tool, the program's output ends there
+    } catch (const std::runtime_error &e) {
+        std::cerr << "hw3: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool emitAst(std::FILE *input, std::ostream &out, const CompileOptions &options) {
+    Source source = Source::read(input);
+    std::unique_ptr<ParsedProgram> program;
+    try {
+        if (options.astInput) {
+            program = loadAstImage(std::move(source));
+        } else {
+            output::Destination destination(std::cerr);
+            program = parseProgram(std::move(source), options.scanner, options.jobs, options.pipeline);
+        }
+    } catch (const output::Aborted &) {
+        return false;
+    } catch (const std::runtime_error &e) {
+        std::cerr << "hw3: " << e.what() << std::endl;
+        return false;
+    }
+    writeAstImage(*program, out);
+    return static_cast<bool>(out.flush());
+}
+
+void scan(std::FILE *input, std::ostream &out, const CompileOptions &options, bool listTokens) {
+    Source source = Source::read(input);
+    output::Destination destination(out);
+    try {
+        std::size_t count = scanProgram(std::move(source), options.scanner, options.jobs, options.pipeline,
+                                        listTokens ? &out : nullptr);
+        if (!listTokens) {
+            out << count << " tokens\n";
+        }
+    } catch (const output::Aborted &) {
+    } catch (const std::runtime_error &e) {
+        std::cerr << "hw3: " << e.what() << std::endl;
+    }
+}
+
+static std::string resultPath(const std::string &input, const std::string &outDir) {
+    std::string path = input;
+    if (!outDir.empty()) {
+        std::size_t slash = path.find_last_of('/');
+        path = outDir + "/" + (slash == std::string::npos ? path : path.substr(slash + 1));
+    }
+    const std::string suffix = ".in";
+    if (path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        path.erase(path.size() - suffix.size());
+    }
+    return path + ".res";
+}
+
+static bool readManifest(const std::string &path, std::vector<std::string> &inputs) {
+    std::ifstream manifest(path);
+    if (!manifest) {
+        std::cerr << "hw3: cannot open manifest " << path << std::endl;
+        return false;
+    }
+    std::string line;
+    while (std::getline(manifest, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            inputs.push_back(line);
+        }
+    }
+    return true;
+}
+
+bool parseBatchArgs(int argc, char *argv[], BatchOptions &options) {
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            options.outDir = argv[++i];
+        } else if (arg == "-j" && i + 1 < argc && parseCount(argv[i + 1], options.jobs)) {
+            ++i;
+        } else if (arg == "-j" || arg == "-o") {
+            std::cerr << "hw3: " << arg << " needs a value" << std::endl;
+            return false;
+        } else if (arg[0] == '@') {
+            if (!readManifest(arg.substr(1), options.inputs)) {
+                return false;
+            }
+        } else {
+            OptionStatus status = parseCompileOption(arg, options.compile);
+            if (status == OptionStatus::BadValue) {
+                return false;
+            }
+            if (status == OptionStatus::Unknown) {
+                options.inputs.push_back(arg);
+            }
+        }
+    }
+    if (options.inputs.empty()) {
+        std::cerr << "usage: hw3 --batch [-j jobs] [-o dir] [--scanner=flex|simd|prelex] [--pipeline] "
+                     "[--lazy | --stream] [--cache=dir] [--ast] "
+                     "[--run | --bytecode | --emit-asm[=stack] | --emit-llvm | --emit-c] [--no-fold] "
+                     "[--stats[=json]] [--trace=file [--trace-scopes=us]] file.in... | @manifest" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int runBatch(const BatchOptions &options) {
+    unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min<unsigned>(jobs, options.inputs.size());
+
+    std::atomic<std::size_t> next(0);
+    std::atomic<bool> failed(false);
+
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < options.inputs.size(); i = next++) {
+            const std::string &input = options.inputs[i];
+            std::FILE *file = std::fopen(input.c_str(), "r");
+            if (file == nullptr) {
+                std::cerr << "hw3: cannot open " + input + "\n";
+                failed = true;
+                continue;
+            }
+            trace::Span span("check", input);
+            std::ostringstream out;
+            std::optional<Stats> stats;
+            if (options.compile.stats != StatsFormat::None) {
+                stats.emplace();
+            }
+            if (!compile(file, out, options.compile, stats ? &*stats : nullptr)) {
+                std::cerr << "hw3: cannot check " + input + "\n";
+                failed = true;
+            }
+            std::fclose(file);
+            if (stats) {
+                stats->print(std::cerr, options.compile.stats, input);
+            }
+
+            std::string path = resultPath(input, options.outDir);
+            std::ofstream res(path, std::ios::binary);
+            res << out.str();
+            if (!res) {
+                std::cerr << "hw3: cannot write " + path + "\n";
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < jobs; ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread: pool) {
+        thread.join();
+    }
+    return failed ? 1 : 0;
+}
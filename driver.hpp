@@ -0,0 +1,110 @@
+#ifndef DRIVER_HPP
+#define DRIVER_HPP
+
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Assembly.hpp"
+#include "frontend.hpp"
+#include "Stats.hpp"
+
+/* How to check one program */
+struct CompileOptions {
+    // Threads for lexing ahead (with the Prelex scanner) and for analyzing function bodies; 0 means one per
+    // hardware thread
+    unsigned jobs = 0;
+    ScannerKind scanner = DEFAULT_SCANNER;
+    // Run the scanner on a thread of its own, feeding the parser through a ring of tokens
+    bool pipeline = false;
+    // Parse function bodies only when the analysis reaches them, and drop each right after (see parseHeaders)
+    bool lazy = false;
+    // Analyze each function as soon as it is parsed and drop it right after, instead of building the whole tree
+    // (see parseStreaming); takes precedence over lazy
+    bool stream = false;
+    // Directory of the analysis cache, which lets unchanged functions skip parsing and analysis (see AnalysisCache);
+    // empty for none. Implies lazy
+    std::string cacheDir;
+    // The input is an image written by --emit-ast instead of FanC source (see AstImage); the options above that
+    // concern scanning and parsing are ignored
+    bool astInput = false;
+    // Report of the phases, the AST, the symbol tables and the memory of the check, on stderr (see Stats). With
+    // lazy, bodies are parsed during pass 2, whose time includes them
+    StatsFormat stats = StatsFormat::None;
+    // After a check without errors, run the program on the bytecode VM (see Vm), or with listBytecode list its
+    // bytecode, instead of printing the scopes. Both need the whole tree, so they take precedence over lazy, stream
+    // and the cache
+    bool run = false;
+    bool listBytecode = false;
+    // After a check without errors, write the program as x86-64 assembly instead of printing the scopes (see
+    // Assembly); like run, it needs the whole tree
+    AsmOutput emitAsm = AsmOutput::None;
+    // After a check without errors, write the program as an LLVM module instead of printing the scopes (see LlvmIr);
+    // it also needs the whole tree
+    bool emitLlvm = false;
+    // Likewise as C (see CSource)
+    bool emitC = false;
+    // Fold constant expressions before running, listing or writing the program (see Folding)
+    bool fold = true;
+    // File to write a Chrome trace of the run to, for chrome://tracing or Perfetto (see Trace); empty for none. It
+    // covers the whole process, so main() starts and writes it rather than compile
+    std::string tracePath;
+    // Scopes open for less than this many microseconds are left out of the trace
+    unsigned traceScopeMicros = 100;
+};
+
+// Reads text as a count: decimal digits only, no sign, fitting in an unsigned. Returns false otherwise
+bool parseCount(const std::string &text, unsigned &value);
+
+/* What parseCompileOption made of an argument */
+enum class OptionStatus {
+    Applied,
+    // An option every mode accepts, with a value it cannot take; a message has been printed to stderr
+    BadValue,
+    Unknown
+};
+
+// Applies arg if it is an option every mode accepts (--scanner=flex|simd|prelex, --pipeline, --lazy, --stream,
+// --cache=dir, --ast, --stats[=json], --trace=file, --trace-scopes=us, --run, --bytecode, --emit-asm[=stack],
+// --emit-llvm, --emit-c, --no-fold)
+OptionStatus parseCompileOption(const std::string &arg, CompileOptions &options);
+
+// Parses and analyzes one program from input and writes exactly what hw3 prints for it to out, measuring the check
+// into stats if given. Returns false, after printing why to stderr, if input is an AST image that cannot be loaded
+bool compile(std::FILE *input, std::ostream &out, const CompileOptions &options, Stats *stats = nullptr);
+
+// Parses the program from input, or loads it with astInput, and writes its AST image to out. Lexical and syntax
+// errors are printed to stderr as compile would print them; returns false after any error
+bool emitAst(std::FILE *input, std::ostream &out, const CompileOptions &options);
+
+// Only scans the program from input and writes the number of tokens, or with listTokens every token, to out
+void scan(std::FILE *input, std::ostream &out, const CompileOptions &options, bool listTokens);
+
+/* Batch mode
+ * Checks every file of a batch in one process on a pool of worker threads. The output for "dir/name.in" is
+ * written to "dir/name.res" (or to outDir/name.res), byte for byte what "hw3 < dir/name.in" would print.
+ */
+struct BatchOptions {
+    std::vector<std::string> inputs;
+    // Directory for the .res files; empty means next to each input
+    std::string outDir;
+    // Number of worker threads; 0 means one per hardware thread
+    unsigned jobs = 0;
+    // Settings for each file; files are already checked in parallel, so each one is analyzed on one thread
+    CompileOptions compile = [] {
+        CompileOptions options;
+        options.jobs = 1;
+        return options;
+    }();
+};
+
+// Parses the arguments following --batch, which may include compile options. Arguments of the form @list name a
+// manifest file holding one input path per line. Returns false (after printing a message to stderr) on malformed
+// arguments.
+bool parseBatchArgs(int argc, char *argv[], BatchOptions &options);
+
+// Runs the batch and returns the process exit status: 0 if every input could be read and every .res written
+int runBatch(const BatchOptions &options);
+
+#endif //DRIVER_HPP
@@ -0,0 +1,116 @@
+#ifndef FRONTEND_HPP
+#define FRONTEND_HPP
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "nodes.hpp"
+#include "Interner.hpp"
+#include "Source.hpp"
+
+/* Stretch of the program text that is parsed on its own after the first parse, and the line it starts on */
+struct SourceSpan {
+    const char *begin;
+    std::size_t length;
+    int line;
+};
+
+/* A parsed FanC program together with the storage its tree points into */
+struct ParsedProgram {
+    // Program text; string literals in the tree are views into it
+    Source source;
+    // Owns every node of the tree the parser builds
+    ast::Arena arena;
+    // Owns the identifier and literal nodes the scanner builds, apart from arena so that a scanner running on a
+    // thread of its own never allocates next to the parser
+    ast::Arena tokenArena;
+    // Spellings of the SymbolIds in the tree
+    ast::Interner names;
+    // Root of the tree
+    ast::Funcs *funcs = nullptr;
+    // After parseHeaders, the body of each function, in order: the text after its { up to and including its }.
+    // Their FuncDecls have no body
+    std::vector<SourceSpan> bodies;
+    // After parseStreaming, the text of each function, in order, from the end of the one before it
+    std::vector<SourceSpan> functions;
+
+    // Constructs a node in the arena and stamps it with the source line it was built at
+    template<typename T, typename... Args>
+    T *make(int line, Args &&... args) {
+        T *node = arena.make<T>(std::forward<Args>(args)...);
+        node->line = line;
+        return node;
+    }
+
+    // Same as make, for the scanner's nodes
+    template<typename T, typename... Args>
+    T *makeToken(int line, Args &&... args) {
+        T *node = tokenArena.make<T>(std::forward<Args>(args)...);
+        node->line = line;
+        return node;
+    }
+};
+
+/* Scanner backends; both produce the same tokens, values, errors and line numbers */
+enum class ScannerKind {
+    // Generated by flex from scanner.lex
+    Flex,
+    // Hand-written, in SimdScanner
+    Simd,
+    // SimdScanner run over the whole text ahead of parsing, in parallel chunks, into a TokenArray
+    Prelex
+};
+
+// Backend used unless another one is requested; build with -DHW3_SIMD_SCANNER to make it the SIMD one
+#ifdef HW3_SIMD_SCANNER
+constexpr ScannerKind DEFAULT_SCANNER = ScannerKind::Simd;
+#else
+constexpr ScannerKind DEFAULT_SCANNER = ScannerKind::Flex;
+#endif
+
+// Parses a whole program, scanning source in place; the result keeps source alive. Lexical and syntax errors are
+// reported through output and throw output::Aborted. Every call owns its scanner and parser state, so calls may
+// run concurrently on any threads. jobs bounds the threads of the Prelex scanner (0: one per hardware thread). With
+// pipeline, a Flex or Simd scanner runs on a thread of its own, a bounded number of tokens ahead of the parser.
+std::unique_ptr<ParsedProgram> parseProgram(Source source, ScannerKind scanner = DEFAULT_SCANNER, unsigned jobs = 0,
+                                            bool pipeline = false);
+
+// Parses a copy of the program held in buf[0..len)
+std::unique_ptr<ParsedProgram> parseProgram(const char *buf, std::size_t len);
+
+// Parses program.source like parseProgram, but skips every function body by brace matching and records where it is
+// in program.bodies instead; the SIMD scanner is used whatever the default. On a syntax error, program.bodies holds
+// the bodies that end before the offending token.
+void parseHeaders(ParsedProgram &program);
+
+// Parses program.bodies[index] into program's arenas. A body that parseHeaders skipped to the end of the text, for
+// lack of a closing brace, is a syntax error here, where a full parse would have found it.
+ast::Statements *parseBody(ParsedProgram &program, std::size_t index);
+
+/* Receives each function of a program parsed by parseStreaming */
+class FunctionSink {
+public:
+    virtual ~FunctionSink() = default;
+
+    // Called with the index-th function as soon as it is parsed; its nodes are freed once this returns
+    virtual void function(std::size_t index, ast::FuncDecl &decl) = 0;
+};
+
+// Parses program.source like parseProgram, but hands every function to sink as soon as it is parsed instead of
+// building a tree, so program.funcs stays null and only one function is in the arenas at a time. program.functions
+// records where each function is, for parseFunction. The SIMD scanner is used whatever the default.
+void parseStreaming(ParsedProgram &program, FunctionSink &sink);
+
+// Parses program.functions[index] into program's arenas again
+ast::FuncDecl *parseFunction(ParsedProgram &program, std::size_t index);
+
+// Only scans source and returns the number of tokens. When tokens is given, every token is listed on it as
+// "line code" followed by the token's value for identifiers and literals. Lexical errors are reported like in
+// parseProgram.
+std::size_t scanProgram(Source source, ScannerKind scanner, unsigned jobs, bool pipeline,
+                        std::ostream *tokens = nullptr);
+
+#endif //FRONTEND_HPP
@@ -1,19 +1,96 @@
 #include "output.hpp"
-#include "SemanticParser.hpp"
 #include "nodes.hpp"
+#include "driver.hpp"
+#include "Trace.hpp"
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <string>
 
-// Extern from the bison-generated parser
-extern int yyparse();
+// Runs one mode of hw3, recording it first if options ask for a trace; a trace that cannot be written fails the run
+template<typename Run>
+static int traced(const CompileOptions &options, Run run) {
+    if (options.tracePath.empty()) {
+        return run();
+    }
+    trace::start(options.tracePath, options.traceScopeMicros);
+    int status = run();
+    return trace::finish() ? status : 1;
+}
+
+int main(int argc, char *argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+
+    // Report the memory layout of the AST instead of compiling
+    if (mode == "--node-sizes") {
+        ast::printNodeSizes(std::cout);
+        return 0;
+    }
 
-extern std::shared_ptr<ast::Node> program;
+    // Check many files in one process: hw3 --batch [-j jobs] [-o dir] file.in... | @manifest
+    if (mode == "--batch") {
+        BatchOptions options;
+        if (!parseBatchArgs(argc - 2, argv + 2, options)) {
+            return 2;
+        }
+        return traced(options.compile, [&] { return runBatch(options); });
+    }
 
-int main() {
-    // Parse the input. The result is stored in the global variable `program`
-    yyparse();
+    // Check the program on stdin:
+    // hw3 [-j jobs] [--scanner=flex|simd|prelex] [--pipeline] [--lazy | --stream] [--cache=dir] [--ast]
+    //     [--run | --bytecode | --emit-asm[=stack] | --emit-llvm | --emit-c] [--no-fold] [--stats[=json]]
+    //     [--trace=file [--trace-scopes=us]]
+    //     [--tokens | --lex | --emit-ast] < file.in
+    // --tokens lists the tokens instead, --lex only counts them, and --emit-ast writes the AST image that --ast reads.
+    // --run runs the program once it checks without errors, and --bytecode lists the bytecode it would run.
+    // --emit-asm writes it as x86-64 assembly instead, with values in machine registers, or with =stack in its frame.
+    // --emit-llvm writes it as an LLVM module, for clang to optimize and compile, and --emit-c as C. All of these fold
+    // constant expressions first, unless --no-fold.
+    // --trace records the run as Chrome trace events, with the scopes open for at least --trace-scopes microseconds
+    CompileOptions options;
+    bool scanOnly = false;
+    bool listTokens = false;
+    bool writeImage = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j") {
+            if (i + 1 >= argc || !parseCount(argv[++i], options.jobs)) {
+                std::cerr << "hw3: -j needs a value" << std::endl;
+                return 2;
+            }
+        } else if (arg == "--tokens" || arg == "--lex") {
+            scanOnly = true;
+            listTokens = arg == "--tokens";
+        } else if (arg == "--emit-ast") {
+            writeImage = true;
+        } else {
+            OptionStatus status = parseCompileOption(arg, options);
+            if (status == OptionStatus::Unknown) {
+                std::cerr << "hw3: unknown option " << arg << std::endl;
+            }
+            if (status != OptionStatus::Applied) {
+                return 2;
+            }
+        }
+    }
 
-    // Print the AST using the PrintVisitor
-    SemanticParser visitor;
-    program->accept(visitor);
-    visitor.print();
-    return 0;
+    return traced(options, [&] {
+        if (writeImage) {
+            return emitAst(stdin, std::cout, options) ? 0 : 1;
+        }
+        if (scanOnly) {
+            scan(stdin, std::cout, options, listTokens);
+            return 0;
+        }
+        std::optional<Stats> stats;
+        if (options.stats != StatsFormat::None) {
+            stats.emplace();
+        }
+        bool compiled = compile(stdin, std::cout, options, stats ? &*stats : nullptr);
+        if (stats) {
+            std::cout.flush();
+            stats->print(std::cerr, options.stats);
+        }
+        return compiled ? 0 : 1;
+    });
 }
@@ -1,117 +1,235 @@
 #include "nodes.hpp"
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 #include <string>
-#include <utility>
-
-extern int yylineno;
 
 namespace ast {
 
-    Node::Node() : line(yylineno) {}
+    Arena::~Arena() {
+        release();
+    }
+
+    void *Arena::allocate(std::size_t size, std::size_t align) {
+        std::size_t pad = (align - reinterpret_cast<std::uintptr_t>(cur) % align) % align;
+        if (cur == nullptr || pad + size > static_cast<std::size_t>(end - cur)) {
+            // Oversized requests get a dedicated block so the common case stays a pointer bump
+            std::size_t blockSize = size + align > BLOCK_SIZE ? size + align : BLOCK_SIZE;
+            char *block = static_cast<char *>(std::malloc(blockSize));
+            if (block == nullptr) {
+                throw std::bad_alloc();
+            }
+            blocks.push_back(block);
+            reserved += blockSize;
+            cur = block;
+            end = block + blockSize;
+            pad = (align - reinterpret_cast<std::uintptr_t>(cur) % align) % align;
+        }
+        void *result = cur + pad;
+        cur += pad + size;
+        used += pad + size;
+        return result;
+    }
+
+    std::string_view Arena::copy(std::string_view text) {
+        char *chars = static_cast<char *>(allocate(text.size(), 1));
+        std::memcpy(chars, text.data(), text.size());
+        return {chars, text.size()};
+    }
+
+    void Arena::release() {
+        for (auto &d: dtors) {
+            d.destroy(d.obj);
+        }
+        dtors.clear();
+        for (char *block: blocks) {
+            std::free(block);
+        }
+        blocks.clear();
+        cur = end = nullptr;
+        used = reserved = 0;
+    }
 
-    Num::Num(const char *str) : Exp(), value(std::stoi(str)) {}
+    void Arena::rewind(const Mark &m) {
+        while (dtors.size() > m.dtors) {
+            dtors.back().destroy(dtors.back().obj);
+            dtors.pop_back();
+        }
+        while (blocks.size() > m.blocks) {
+            std::free(blocks.back());
+            blocks.pop_back();
+        }
+        cur = m.cur;
+        end = m.end;
+        used = m.used;
+        reserved = m.reserved;
+    }
 
-    NumB::NumB(const char *str) : Exp() {
-        std::string s(str);
-        if (!s.empty() && (s.back() == 'b' || s.back() == 'B')) {
-            s.pop_back();
+    Node::Node(NodeKind kind) : line(0), kind(kind) {}
+
+    void Node::accept(Visitor &visitor) {
+        switch (kind) {
+            case NodeKind::Num: visitor.visit(static_cast<Num &>(*this)); break;
+            case NodeKind::NumB: visitor.visit(static_cast<NumB &>(*this)); break;
+            case NodeKind::String: visitor.visit(static_cast<String &>(*this)); break;
+            case NodeKind::Bool: visitor.visit(static_cast<Bool &>(*this)); break;
+            case NodeKind::ID: visitor.visit(static_cast<ID &>(*this)); break;
+            case NodeKind::BinOp: visitor.visit(static_cast<BinOp &>(*this)); break;
+            case NodeKind::RelOp: visitor.visit(static_cast<RelOp &>(*this)); break;
+            case NodeKind::Not: visitor.visit(static_cast<Not &>(*this)); break;
+            case NodeKind::And: visitor.visit(static_cast<And &>(*this)); break;
+            case NodeKind::Or: visitor.visit(static_cast<Or &>(*this)); break;
+            case NodeKind::Type: visitor.visit(static_cast<Type &>(*this)); break;
+            case NodeKind::Cast: visitor.visit(static_cast<Cast &>(*this)); break;
+            case NodeKind::ExpList: visitor.visit(static_cast<ExpList &>(*this)); break;
+            case NodeKind::Call: visitor.visit(static_cast<Call &>(*this)); break;
+            case NodeKind::Statements: visitor.visit(static_cast<Statements &>(*this)); break;
+            case NodeKind::Break: visitor.visit(static_cast<Break &>(*this)); break;
+            case NodeKind::Continue: visitor.visit(static_cast<Continue &>(*this)); break;
+            case NodeKind::Return: visitor.visit(static_cast<Return &>(*this)); break;
+            case NodeKind::If: visitor.visit(static_cast<If &>(*this)); break;
+            case NodeKind::While: visitor.visit(static_cast<While &>(*this)); break;
+            case NodeKind::VarDecl: visitor.visit(static_cast<VarDecl &>(*this)); break;
+            case NodeKind::Assign: visitor.visit(static_cast<Assign &>(*this)); break;
+            case NodeKind::Formal: visitor.visit(static_cast<Formal &>(*this)); break;
+            case NodeKind::Formals: visitor.visit(static_cast<Formals &>(*this)); break;
+            case NodeKind::FuncDecl: visitor.visit(static_cast<FuncDecl &>(*this)); break;
+            case NodeKind::Funcs: visitor.visit(static_cast<Funcs &>(*this)); break;
         }
-        value = std::stoi(s);
     }
-    String::String(const char *str) : Exp(), value(str) {
-        // Remove the quotes
-        value = value.substr(1, value.size() - 2);
+
+    // Parses a decimal literal without copying it; throws std::runtime_error, which the driver reports for the file
+    // being compiled, if it does not fit in an int
+    static int parseLiteral(std::string_view digits) {
+        int value = 0;
+        auto result = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+        if (result.ec == std::errc::result_out_of_range) {
+            throw std::runtime_error("literal out of range: " + std::string(digits));
+        }
+        return value;
     }
 
-    Bool::Bool(bool value) : Exp(), value(value) {}
+    Num::Num(std::string_view text) : Exp(NodeKind::Num), value(parseLiteral(text)) {}
 
-    ID::ID(const char *str) : Exp(), value(str) {}
+    Num::Num(int value) : Exp(NodeKind::Num), value(value) {}
 
-    BinOp::BinOp(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right, BinOpType op)
-            : Exp(), left(std::move(left)), right(std::move(right)), op(op) {}
+    NumB::NumB(std::string_view text) : Exp(NodeKind::NumB) {
+        if (!text.empty() && (text.back() == 'b' || text.back() == 'B')) {
+            text.remove_suffix(1);
+        }
+        value = parseLiteral(text);
+    }
 
-    RelOp::RelOp(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right, RelOpType op)
-            : Exp(), left(std::move(left)), right(std::move(right)), op(op) {}
+    NumB::NumB(int value) : Exp(NodeKind::NumB), value(value) {}
 
-    Type::Type(BuiltInType type) : Node(), type(type) {}
+    String::String(std::string_view value)
+            : Exp(NodeKind::String), chars(value.data()), length(static_cast<std::uint32_t>(value.size())) {}
 
-    Cast::Cast(std::shared_ptr<Exp> exp, std::shared_ptr<Type> target_type)
-            : Exp(), exp(std::move(exp)), target_type(std::move(target_type)) {}
+    Bool::Bool(bool value) : Exp(NodeKind::Bool), value(value) {}
 
-    Not::Not(std::shared_ptr<Exp> exp) : Exp(), exp(std::move(exp)) {}
+    ID::ID(SymbolId value) : Exp(NodeKind::ID), value(value) {}
 
-    And::And(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right)
-            : Exp(), left(std::move(left)), right(std::move(right)) {}
+    BinOp::BinOp(Exp *left, Exp *right, BinOpType op)
+            : Exp(NodeKind::BinOp), op(op), left(left), right(right) {}
 
-    Or::Or(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right)
-            : Exp(), left(std::move(left)), right(std::move(right)) {}
+    RelOp::RelOp(Exp *left, Exp *right, RelOpType op)
+            : Exp(NodeKind::RelOp), op(op), left(left), right(right) {}
 
-    ExpList::ExpList(std::shared_ptr<Exp> exp) : Node(), exps({std::move(exp)}) {}
+    Type::Type(BuiltInType type) : Node(NodeKind::Type), type(type) {}
 
-    void ExpList::push_front(const std::shared_ptr<Exp> &exp) {
-        exps.insert(exps.begin(), exp);
-    }
+    Cast::Cast(Exp *exp, Type *target_type)
+            : Exp(NodeKind::Cast), exp(exp), target_type(target_type) {}
 
-    void ExpList::push_back(const std::shared_ptr<Exp> &exp) {
-        exps.push_back(exp);
-    }
+    Not::Not(Exp *exp) : Exp(NodeKind::Not), exp(exp) {}
 
-    Call::Call(std::shared_ptr<ID> func_id, std::shared_ptr<ExpList> args)
-            : Exp(), func_id(std::move(func_id)), args(std::move(args)) {}
+    And::And(Exp *left, Exp *right)
+            : Exp(NodeKind::And), left(left), right(right) {}
 
-    Call::Call(std::shared_ptr<ID> func_id)
-            : Exp(), func_id(std::move(func_id)), args(std::make_shared<ExpList>()) {}
+    Or::Or(Exp *left, Exp *right)
+            : Exp(NodeKind::Or), left(left), right(right) {}
 
-    Statements::Statements(std::shared_ptr<Statement> statement) : Statement(), statements({std::move(statement)}) {}
+    ExpList::ExpList() : Node(NodeKind::ExpList) {}
 
-    void Statements::push_front(const std::shared_ptr<Statement> &statement) {
-        statements.insert(statements.begin(), statement);
+    void ExpList::push_back(Arena &arena, Exp *exp) {
+        exps.push_back(arena, exp);
     }
 
-    void Statements::push_back(const std::shared_ptr<Statement> &statement) {
-        statements.push_back(statement);
+    Call::Call(ID *func_id, ExpList *args)
+            : Exp(NodeKind::Call), func_id(func_id), args(args) {}
+
+    Statements::Statements() : Statement(NodeKind::Statements) {}
+
+    void Statements::push_back(Arena &arena, Statement *statement) {
+        statements.push_back(arena, statement);
     }
 
-    Return::Return(std::shared_ptr<Exp> exp) : Statement(), exp(std::move(exp)) {}
+    Break::Break() : Statement(NodeKind::Break) {}
 
-    If::If(std::shared_ptr<Exp> condition, std::shared_ptr<Statement> then, std::shared_ptr<Statement> otherwise)
-            : Statement(), condition(std::move(condition)), then(std::move(then)), otherwise(std::move(otherwise)) {}
+    Continue::Continue() : Statement(NodeKind::Continue) {}
 
-    While::While(std::shared_ptr<Exp> condition, std::shared_ptr<Statement> body)
-            : Statement(), condition(std::move(condition)),
-              body(std::move(body)) {}
+    Return::Return(Exp *exp) : Statement(NodeKind::Return), exp(exp) {}
 
-    VarDecl::VarDecl(std::shared_ptr<ID> id, std::shared_ptr<Type> type, std::shared_ptr<Exp> init_exp)
-            : Statement(), id(std::move(std::move(id))), type(std::move(type)), init_exp(std::move(init_exp)) {}
+    If::If(Exp *condition, Statement *then, Statement *otherwise)
+            : Statement(NodeKind::If), condition(condition), then(then), otherwise(otherwise) {}
 
-    Assign::Assign(std::shared_ptr<ID> id, std::shared_ptr<Exp> exp)
-            : Statement(), id(std::move(id)), exp(std::move(exp)) {}
+    While::While(Exp *condition, Statement *body)
+            : Statement(NodeKind::While), condition(condition),
+              body(body) {}
 
-    Formal::Formal(std::shared_ptr<ID> id, std::shared_ptr<Type> type)
-            : Node(), id(std::move(id)), type(std::move(type)) {}
+    VarDecl::VarDecl(ID *id, Type *type, Exp *init_exp)
+            : Statement(NodeKind::VarDecl), id(id), type(type), init_exp(init_exp) {}
 
-    Formals::Formals(std::shared_ptr<Formal> formal) : Node(), formals({std::move(formal)}) {}
+    Assign::Assign(ID *id, Exp *exp)
+            : Statement(NodeKind::Assign), id(id), exp(exp) {}
 
-    void Formals::push_front(const std::shared_ptr<Formal> &formal) {
-        formals.insert(formals.begin(), formal);
-    }
+    Formal::Formal(ID *id, Type *type)
+            : Node(NodeKind::Formal), id(id), type(type) {}
+
+    Formals::Formals() : Node(NodeKind::Formals) {}
 
-    void Formals::push_back(const std::shared_ptr<Formal> &formal) {
-        formals.push_back(formal);
+    void Formals::push_back(Arena &arena, Formal *formal) {
+        formals.push_back(arena, formal);
     }
 
-    FuncDecl::FuncDecl(std::shared_ptr<ID> id, std::shared_ptr<Type> return_type, std::shared_ptr<Formals> formals,
-                       std::shared_ptr<Statements> body)
-            : Node(), id(std::move(id)), return_type(std::move(return_type)), formals(std::move(formals)),
-              body(std::move(body)) {}
+    FuncDecl::FuncDecl(ID *id, Type *return_type, Formals *formals,
+                       Statements *body)
+            : Node(NodeKind::FuncDecl), id(id), return_type(return_type), formals(formals),
+              body(body) {}
 
-    Funcs::Funcs(std::shared_ptr<FuncDecl> func) : Node(), funcs({std::move(func)}) {}
+    Funcs::Funcs() : Node(NodeKind::Funcs) {}
 
-    void Funcs::push_front(const std::shared_ptr<FuncDecl> &func) {
-        funcs.insert(funcs.begin(), func);
+    void Funcs::push_back(Arena &arena, FuncDecl *func) {
+        funcs.push_back(arena, func);
     }
 
-    void Funcs::push_back(const std::shared_ptr<FuncDecl> &func) {
-        funcs.push_back(func);
+    void printNodeSizes(std::ostream &os) {
+        os << "Num " << sizeof(Num) << "\n"
+           << "NumB " << sizeof(NumB) << "\n"
+           << "String " << sizeof(String) << "\n"
+           << "Bool " << sizeof(Bool) << "\n"
+           << "ID " << sizeof(ID) << "\n"
+           << "BinOp " << sizeof(BinOp) << "\n"
+           << "RelOp " << sizeof(RelOp) << "\n"
+           << "Not " << sizeof(Not) << "\n"
+           << "And " << sizeof(And) << "\n"
+           << "Or " << sizeof(Or) << "\n"
+           << "Type " << sizeof(Type) << "\n"
+           << "Cast " << sizeof(Cast) << "\n"
+           << "ExpList " << sizeof(ExpList) << "\n"
+           << "Call " << sizeof(Call) << "\n"
+           << "Statements " << sizeof(Statements) << "\n"
+           << "Break " << sizeof(Break) << "\n"
+           << "Continue " << sizeof(Continue) << "\n"
+           << "Return " << sizeof(Return) << "\n"
+           << "If " << sizeof(If) << "\n"
+           << "While " << sizeof(While) << "\n"
+           << "VarDecl " << sizeof(VarDecl) << "\n"
+           << "Assign " << sizeof(Assign) << "\n"
+           << "Formal " << sizeof(Formal) << "\n"
+           << "Formals " << sizeof(Formals) << "\n"
+           << "FuncDecl " << sizeof(FuncDecl) << "\n"
+           << "Funcs " << sizeof(Funcs) << "\n";
     }
 
 }
@@ -1,15 +1,92 @@
 #ifndef NODES_HPP
 #define NODES_HPP
 
-#include <memory>
-#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "visitor.hpp"
+#include "Interner.hpp"
 
 namespace ast {
 
+    /* Bump-pointer arena that owns every AST node of a single compilation.
+     * Nodes refer to their children through non-owning Refs, and the whole tree is released at once
+     * when the arena is destroyed (or release() is called), without walking it.
+     */
+    class Arena {
+    public:
+        Arena() = default;
+
+        Arena(const Arena &) = delete;
+
+        Arena &operator=(const Arena &) = delete;
+
+        ~Arena();
+
+        // Constructs a T inside the arena and returns a non-owning pointer to it
+        template<typename T, typename... Args>
+        T *make(Args &&... args) {
+            T *obj = new(allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if (!std::is_trivially_destructible<T>::value) {
+                dtors.push_back({[](void *p) { static_cast<T *>(p)->~T(); }, obj});
+            }
+            return obj;
+        }
+
+        // Returns size bytes of raw storage aligned to align
+        void *allocate(std::size_t size, std::size_t align);
+
+        // Copies text into the arena and returns a view of the copy
+        std::string_view copy(std::string_view text);
+
+        // Destroys every object and frees every block. The arena may be reused afterwards
+        void release();
+
+        /* Allocation state saved by mark() */
+        struct Mark {
+            std::size_t blocks;
+            std::size_t dtors;
+            char *cur;
+            char *end;
+            std::size_t used;
+            std::size_t reserved;
+        };
+
+        Mark mark() const { return {blocks.size(), dtors.size(), cur, end, used, reserved}; }
+
+        // Destroys the objects made since m was taken, frees the blocks obtained since, and hands their storage out
+        // again. Nothing made since m may be used afterwards
+        void rewind(const Mark &m);
+
+        // Number of bytes handed out since construction (or the last release), including alignment padding
+        std::size_t bytesUsed() const { return used; }
+
+        // Number of bytes obtained from the system for the blocks
+        std::size_t bytesReserved() const { return reserved; }
+
+    private:
+        struct Dtor {
+            void (*destroy)(void *);
+            void *obj;
+        };
+
+        static constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+        std::vector<char *> blocks;
+        std::vector<Dtor> dtors;
+        char *cur = nullptr;
+        char *end = nullptr;
+        std::size_t used = 0;
+        std::size_t reserved = 0;
+    };
+
     /* Arithmetic operations */
-    enum BinOpType {
+    enum BinOpType : unsigned char {
         ADD, // Addition
         SUB, // Subtraction
         MUL, // Multiplication
@@ -17,7 +94,7 @@ namespace ast {
     };
 
     /* Relational operations */
-    enum RelOpType {
+    enum RelOpType : unsigned char {
         EQ, // Equal
         NE, // Not equal
         LT, // Less than
@@ -27,7 +104,7 @@ namespace ast {
     };
 
     /* Built-in types */
-    enum BuiltInType {
+    enum BuiltInType : unsigned char {
         VOID,
         BOOL,
         BYTE,
@@ -35,27 +112,124 @@ namespace ast {
         STRING
     };
 
-    /* Base class for all AST nodes */
+    /* Concrete node classes, used as a compact tag for static dispatch */
+    enum class NodeKind : unsigned char {
+        Num, NumB, String, Bool, ID, BinOp, RelOp, Not, And, Or, Type, Cast, ExpList, Call,
+        Statements, Break, Continue, Return, If, While, VarDecl, Assign, Formal, Formals, FuncDecl, Funcs
+    };
+
+    /* Base class for all AST nodes
+     * Nodes have no virtual functions: the kind tag identifies the concrete class, so a node costs no vtable
+     * pointer and subclasses can place their narrow fields in the tail padding after the tag. They hold no absolute
+     * addresses either: children and string characters are reached through Refs.
+     */
     class Node {
     public:
         // Line number in the source code
         int line;
+        // Concrete class of this node
+        NodeKind kind;
 
-        // Use this constructor only while parsing in bison or flex
-        Node();
+        // The line starts at 0; whoever builds the tree stamps it (see ParsedProgram::make)
+        explicit Node(NodeKind kind);
 
-        // Accept method for visitor pattern
-        virtual void accept(Visitor &visitor) = 0;
+        // Accept method for visitor pattern, dispatching on the kind tag
+        void accept(Visitor &visitor);
     };
 
-    /* Base class for all expressions */
-    class Exp : virtual public Node {
+    /* Base class for all statements */
+    class Statement : public Node {
     public:
-        Exp() = default;
+        using Node::Node;
     };
 
-    /* Base class for all statements */
-    class Statement : virtual public Node {
+    /* Base class for all expressions
+     * Expressions derive from Statement so that a call can stand as a statement without a second Node base;
+     * the grammar only lets calls appear in statement position.
+     */
+    class Exp : public Statement {
+    public:
+        using Statement::Statement;
+    };
+
+    /* Non-owning pointer stored as the distance from itself to its target
+     * Nodes refer to their children through Refs, so a tree whose nodes all lie in one block of memory stays valid
+     * when the block is copied or mapped at another address as a whole (see AstImage).
+     */
+    template<typename T>
+    class Ref {
+    public:
+        Ref(T *target = nullptr) { set(target); }
+
+        Ref(const Ref &other) { set(other.get()); }
+
+        Ref &operator=(const Ref &other) {
+            set(other.get());
+            return *this;
+        }
+
+        Ref &operator=(T *target) {
+            set(target);
+            return *this;
+        }
+
+        T *get() const { return offset == 0 ? nullptr : reinterpret_cast<T *>(address() + offset); }
+
+        operator T *() const { return get(); }
+
+        T *operator->() const { return get(); }
+
+        T &operator*() const { return *get(); }
+
+    private:
+        // 0 stands for null, since nothing points at one of its own fields
+        std::intptr_t offset = 0;
+
+        std::intptr_t address() const { return reinterpret_cast<std::intptr_t>(this); }
+
+        void set(T *target) {
+            offset = target == nullptr ? 0 : reinterpret_cast<std::intptr_t>(target) - address();
+        }
+    };
+
+    /* Growable array of child references whose storage is taken from the arena */
+    template<typename T>
+    class List {
+    public:
+        // Appends item, moving the array to a larger arena allocation when it is full
+        void push_back(Arena &arena, T *item) {
+            if (count == capacity) {
+                std::uint32_t newCapacity = capacity == 0 ? 4 : capacity * 2;
+                auto *grown = static_cast<Ref<T> *>(arena.allocate(newCapacity * sizeof(Ref<T>), alignof(Ref<T>)));
+                for (std::uint32_t i = 0; i < count; ++i) {
+                    new(grown + i) Ref<T>(items.get()[i]);
+                }
+                items = grown;
+                capacity = newCapacity;
+            }
+            new(items.get() + count++) Ref<T>(item);
+        }
+
+        // Makes the list hold the first n references of storage, which is not copied and must outlive the list
+        void adopt(Ref<T> *storage, std::uint32_t n) {
+            items = storage;
+            count = capacity = n;
+        }
+
+        Ref<T> *begin() const { return items; }
+
+        Ref<T> *end() const { return items.get() + count; }
+
+        T *operator[](std::size_t i) const { return items.get()[i]; }
+
+        std::size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+    private:
+        Ref<Ref<T>> items;
+        std::uint32_t count = 0;
+        std::uint32_t capacity = 0;
     };
 
     /* Number literal */
@@ -64,12 +238,11 @@ namespace ast {
         // Value of the number
         int value;
 
-        // Constructor that receives a C-style string that represents the number
-        explicit Num(const char *str);
+        // Constructor that receives the digits of the number
+        explicit Num(std::string_view text);
 
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        // Constructor that receives the value of the number
+        explicit Num(int value);
     };
 
     /* Byte literal */
@@ -78,26 +251,26 @@ namespace ast {
         // Value of the number
         int value;
 
-        // Constructor that receives a C-style (including b character) string that represents the number
-        explicit NumB(const char *str);
+        // Constructor that receives the digits of the number, optionally followed by the b suffix
+        explicit NumB(std::string_view text);
 
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        // Constructor that receives the value of the number
+        explicit NumB(int value);
     };
 
     /* String literal */
     class String : public Exp {
     public:
-        // Value of the string
-        std::string value;
+        // Characters of the string, without the quotes. They belong to the program's source text
+        Ref<const char> chars;
+        // Number of characters
+        std::uint32_t length;
 
-        // Constructor that receives a C-style string that represents the string *including quotes*
-        explicit String(const char *str);
+        // Constructor that receives the string without its quotes; the characters must outlive the node
+        explicit String(std::string_view value);
 
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        // Value of the string, without the quotes
+        std::string_view value() const { return {chars.get(), length}; }
     };
 
     /* Boolean literal */
@@ -108,106 +281,78 @@ namespace ast {
 
         // Constructor that receives the boolean value
         explicit Bool(bool value);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
     };
 
     /* Identifier */
     class ID : public Exp {
     public:
-        // Name of the identifier
-        std::string value;
+        // Interned name of the identifier; the spelling is only looked up when printing
+        SymbolId value;
 
-        // Constructor that receives a C-style string that represents the identifier
-        explicit ID(const char *str);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        // Constructor that receives the interned name of the identifier
+        explicit ID(SymbolId value);
     };
 
     /* Binary arithmetic operation */
     class BinOp : public Exp {
     public:
-        // Left operand
-        std::shared_ptr<Exp> left;
-        // Right operand
-        std::shared_ptr<Exp> right;
         // Operation
         BinOpType op;
+        // Left operand
+        Ref<Exp> left;
+        // Right operand
+        Ref<Exp> right;
 
         // Constructor that receives the left and right operands and the operation
-        BinOp(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right, BinOpType op);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        BinOp(Exp *left, Exp *right, BinOpType op);
     };
 
     /* Binary relational operation */
     class RelOp : public Exp {
     public:
-        // Left operand
-        std::shared_ptr<Exp> left;
-        // Right operand
-        std::shared_ptr<Exp> right;
         // Operation
         RelOpType op;
+        // Left operand
+        Ref<Exp> left;
+        // Right operand
+        Ref<Exp> right;
 
         // Constructor that receives the left and right operands and the operation
-        RelOp(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right, RelOpType op);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        RelOp(Exp *left, Exp *right, RelOpType op);
     };
 
     /* Unary logical NOT operation */
     class Not : public Exp {
     public:
         // Operand
-        std::shared_ptr<Exp> exp;
+        Ref<Exp> exp;
 
         // Constructor that receives the operand
-        explicit Not(std::shared_ptr<Exp> exp);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        explicit Not(Exp *exp);
     };
 
     /* Binary logical AND operation */
     class And : public Exp {
     public:
         // Left operand
-        std::shared_ptr<Exp> left;
+        Ref<Exp> left;
         // Right operand
-        std::shared_ptr<Exp> right;
+        Ref<Exp> right;
 
         // Constructor that receives the left and right operands
-        And(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        And(Exp *left, Exp *right);
     };
 
     /* Binary logical OR operation */
     class Or : public Exp {
     public:
         // Left operand
-        std::shared_ptr<Exp> left;
+        Ref<Exp> left;
         // Right operand
-        std::shared_ptr<Exp> right;
+        Ref<Exp> right;
 
         // Constructor that receives the left and right operands
-        Or(std::shared_ptr<Exp> left, std::shared_ptr<Exp> right);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        Or(Exp *left, Exp *right);
     };
 
     /* Type symbol */
@@ -218,274 +363,190 @@ namespace ast {
 
         // Constructor that receives the type
         explicit Type(BuiltInType type);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
     };
 
     /* Type cast */
     class Cast : public Exp {
     public:
         // Expression to be cast
-        std::shared_ptr<Exp> exp;
+        Ref<Exp> exp;
         // Target type
-        std::shared_ptr<Type> target_type;
+        Ref<Type> target_type;
 
         // Constructor that receives the expression and the target type
-        Cast(std::shared_ptr<Exp> exp, std::shared_ptr<Type> type);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        Cast(Exp *exp, Type *type);
     };
 
     /* List of expressions */
     class ExpList : public Node {
     public:
         // List of expressions
-        std::vector<std::shared_ptr<Exp>> exps;
+        List<Exp> exps;
 
         // Constructor that receives no expressions
-        ExpList() = default;
-
-        // Constructor that receives the first expression
-        explicit ExpList(std::shared_ptr<Exp> exp);
-
-        // Method to add an expression at the beginning of the list
-        void push_front(const std::shared_ptr<Exp> &exp);
+        ExpList();
 
         // Method to add an expression at the end of the list
-        void push_back(const std::shared_ptr<Exp> &exp);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        void push_back(Arena &arena, Exp *exp);
     };
 
     /* Function call */
-    class Call : public Exp, public Statement {
+    class Call : public Exp {
     public:
         // Function identifier
-        std::shared_ptr<ID> func_id;
+        Ref<ID> func_id;
         // List of arguments as expressions
-        std::shared_ptr<ExpList> args;
+        Ref<ExpList> args;
 
         // Constructor that receives the function identifier and the list of arguments
-        Call(std::shared_ptr<ID> func_id, std::shared_ptr<ExpList> args);
-
-        // Constructor that receives only the function identifier (for parameterless functions)
-        explicit Call(std::shared_ptr<ID> func_id);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        Call(ID *func_id, ExpList *args);
     };
 
     /* List of statements */
     class Statements : public Statement {
     public:
         // List of statements
-        std::vector<std::shared_ptr<Statement>> statements;
+        List<Statement> statements;
 
         // Constructor that receives no statements
-        Statements() = default;
-
-        // Constructor that receives the first statement
-        explicit Statements(std::shared_ptr<Statement> statement);
-
-        // Method to add a statement at the beginning of the list
-        void push_front(const std::shared_ptr<Statement> &statement);
+        Statements();
 
         // Method to add a statement at the end of the list
-        void push_back(const std::shared_ptr<Statement> &statement);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        void push_back(Arena &arena, Statement *statement);
     };
 
     /* Break statement */
     class Break : public Statement {
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+    public:
+        Break();
     };
 
     /* Continue statement */
     class Continue : public Statement {
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+    public:
+        Continue();
     };
 
     /* Return statement */
     class Return : public Statement {
     public:
         // Expression to be returned. If the return is expressionless, this field is nullptr
-        std::shared_ptr<Exp> exp;
+        Ref<Exp> exp;
 
         // Constructor that receives the expression to be returned
-        explicit Return(std::shared_ptr<Exp> exp = nullptr);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        explicit Return(Exp *exp = nullptr);
     };
 
     /* If statement */
     class If : public Statement {
     public:
         // Condition expression
-        std::shared_ptr<Exp> condition;
+        Ref<Exp> condition;
         // Statement to be executed if the condition is true
-        std::shared_ptr<Statement> then;
+        Ref<Statement> then;
         // Statement to be executed if the condition is false. For an if statement without else, this field is nullptr
-        std::shared_ptr<Statement> otherwise;
+        Ref<Statement> otherwise;
 
         // Constructor that receives the condition, the statement to be executed if the condition is true, and the statement to be executed if the condition is false
-        If(std::shared_ptr<Exp> condition, std::shared_ptr<Statement> then,
-           std::shared_ptr<Statement> otherwise = nullptr);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        If(Exp *condition, Statement *then,
+           Statement *otherwise = nullptr);
     };
 
     /* While statement */
     class While : public Statement {
     public:
         // Condition expression
-        std::shared_ptr<Exp> condition;
+        Ref<Exp> condition;
         // Statement to be executed while the condition is true
-        std::shared_ptr<Statement> body;
+        Ref<Statement> body;
 
         // Constructor that receives the condition and the statement to be executed while the condition is true
-        While(std::shared_ptr<Exp> condition, std::shared_ptr<Statement> body);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        While(Exp *condition, Statement *body);
     };
 
     /* Variable declaration */
     class VarDecl : public Statement {
     public:
         // Identifier of the variable
-        std::shared_ptr<ID> id;
+        Ref<ID> id;
         // Type of the variable
-        std::shared_ptr<Type> type;
+        Ref<Type> type;
         // Initial value of the variable. If the variable is not initialized, this field is nullptr
-        std::shared_ptr<Exp> init_exp;
+        Ref<Exp> init_exp;
 
         // Constructor that receives the identifier, the type, and the initial value expression
-        VarDecl(std::shared_ptr<ID> id, std::shared_ptr<Type> type, std::shared_ptr<Exp> init_exp = nullptr);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        VarDecl(ID *id, Type *type, Exp *init_exp = nullptr);
     };
 
     /* Assignment statement */
     class Assign : public Statement {
     public:
         // Identifier of the variable
-        std::shared_ptr<ID> id;
+        Ref<ID> id;
         // Expression to be assigned
-        std::shared_ptr<Exp> exp;
+        Ref<Exp> exp;
 
         // Constructor that receives the identifier and the expression to be assigned
-        Assign(std::shared_ptr<ID> id, std::shared_ptr<Exp> exp);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        Assign(ID *id, Exp *exp);
     };
 
     /* Formal parameter */
     class Formal : public Node {
     public:
         // Identifier of the parameter
-        std::shared_ptr<ID> id;
+        Ref<ID> id;
         // Type of the parameter
-        std::shared_ptr<Type> type;
+        Ref<Type> type;
 
         // Constructor that receives the identifier and the type
-        Formal(std::shared_ptr<ID> id, std::shared_ptr<Type> type);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        Formal(ID *id, Type *type);
     };
 
     /* List of formal parameters */
     class Formals : public Node {
     public:
         // List of formal parameters
-        std::vector<std::shared_ptr<Formal>> formals;
+        List<Formal> formals;
 
         // Constructor that receives no parameters
-        Formals() = default;
-
-        // Constructor that receives the first formal parameter
-        explicit Formals(std::shared_ptr<Formal> formal);
-
-        // Method to add a formal parameter at the beginning of the list
-        void push_front(const std::shared_ptr<Formal> &formal);
+        Formals();
 
         // Method to add a formal parameter at the end of the list
-        void push_back(const std::shared_ptr<Formal> &formal);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        void push_back(Arena &arena, Formal *formal);
     };
 
     /* Function declaration */
     class FuncDecl : public Node {
     public:
         // Identifier of the function
-        std::shared_ptr<ID> id;
+        Ref<ID> id;
         // Return type of the function
-        std::shared_ptr<Type> return_type;
+        Ref<Type> return_type;
         // List of formal parameters
-        std::shared_ptr<Formals> formals;
+        Ref<Formals> formals;
         // Body of the function
-        std::shared_ptr<Statements> body;
+        Ref<Statements> body;
 
         // Constructor that receives the identifier, the return type, the list of formal parameters, and the body
-        FuncDecl(std::shared_ptr<ID> id, std::shared_ptr<Type> return_type, std::shared_ptr<Formals> formals,
-                 std::shared_ptr<Statements> body);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        FuncDecl(ID *id, Type *return_type, Formals *formals,
+                 Statements *body);
     };
 
     /* List of function declarations */
     class Funcs : public Node {
     public:
         // List of function declarations
-        std::vector<std::shared_ptr<FuncDecl>> funcs;
+        List<FuncDecl> funcs;
 
         // Constructor that receives no function declarations
-        Funcs() = default;
-
-        // Constructor that receives the first function declaration
-        explicit Funcs(std::shared_ptr<FuncDecl> func);
-
-        // Method to add a function declaration at the beginning of the list
-        void push_front(const std::shared_ptr<FuncDecl> &func);
+        Funcs();
 
         // Method to add a function declaration at the end of the list
-        void push_back(const std::shared_ptr<FuncDecl> &func);
-
-        void accept(Visitor &visitor) override {
-            visitor.visit(*this);
-        }
+        void push_back(Arena &arena, FuncDecl *func);
     };
-}
 
-//#define YYSTYPE std::shared_ptr<ast::Node>
+    // Writes the size in bytes of every node class, one "name size" pair per line
+    void printNodeSizes(std::ostream &os);
+}
 
 #endif //NODES_HPP
@@ -1,10 +1,18 @@
 #include "output.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <climits>
+#include <system_error>
+#include <sys/uio.h>
+#include <unistd.h>
 
 namespace output {
     /* Helper functions */
 
-    static std::string toString(ast::BuiltInType type) {
+    static std::string_view toString(ast::BuiltInType type) {
         switch (type) {
             case ast::BuiltInType::INT:
                 return "int";
@@ -21,125 +29,382 @@ namespace output {
         }
     }
 
+    /* Output destination */
+
+    namespace {
+        thread_local std::ostream *currentStream = &std::cout;
+        thread_local const ast::Interner *currentNames = nullptr;
+    }
+
+    Destination::Destination(std::ostream &stream, const ast::Interner *names)
+            : prevStream(currentStream), prevNames(currentNames) {
+        currentStream = &stream;
+        currentNames = names;
+    }
+
+    Destination::~Destination() {
+        currentStream = prevStream;
+        currentNames = prevNames;
+    }
+
+    void Destination::setNames(const ast::Interner *names) {
+        currentNames = names;
+    }
+
+    std::ostream &Destination::stream() {
+        return *currentStream;
+    }
+
+    const ast::Interner &Destination::names() {
+        return *currentNames;
+    }
+
     /* Error handling functions */
 
     void errorLex(int lineno) {
-        std::cout << "line " << lineno << ": lexical error\n";
-        exit(0);
+        Destination::stream() << "line " << lineno << ": lexical error\n";
+        throw Aborted();
     }
 
     void errorSyn(int lineno) {
-        std::cout << "line " << lineno << ": syntax error\n";
-        exit(0);
+        Destination::stream() << "line " << lineno << ": syntax error\n";
+        throw Aborted();
     }
 
     void errorUndef(int lineno, const std::string &id) {
-        std::cout << "line " << lineno << ":" << " variable " << id << " is not defined" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " variable " << id << " is not defined" << std::endl;
+        throw Aborted();
     }
 
     void errorDefAsFunc(int lineno, const std::string &id) {
-        std::cout << "line " << lineno << ":" << " symbol " << id << " is a function" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " symbol " << id << " is a function" << std::endl;
+        throw Aborted();
     }
 
     void errorDefAsVar(int lineno, const std::string &id) {
-        std::cout << "line " << lineno << ":" << " symbol " << id << " is a variable" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " symbol " << id << " is a variable" << std::endl;
+        throw Aborted();
     }
 
     void errorDef(int lineno, const std::string &id) {
-        std::cout << "line " << lineno << ":" << " symbol " << id << " is already defined" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " symbol " << id << " is already defined" << std::endl;
+        throw Aborted();
     }
 
     void errorUndefFunc(int lineno, const std::string &id) {
-        std::cout << "line " << lineno << ":" << " function " << id << " is not defined" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " function " << id << " is not defined" << std::endl;
+        throw Aborted();
     }
 
     void errorMismatch(int lineno) {
-        std::cout << "line " << lineno << ":" << " type mismatch" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " type mismatch" << std::endl;
+        throw Aborted();
     }
 
     void errorPrototypeMismatch(int lineno, const std::string &id, std::vector<std::string> &paramTypes) {
-        std::cout << "line " << lineno << ": prototype mismatch, function " << id << " expects parameters (";
+        Destination::stream() << "line " << lineno << ": prototype mismatch, function " << id << " expects parameters (";
 
         for (int i = 0; i < paramTypes.size(); ++i) {
-            std::cout << paramTypes[i];
+            Destination::stream() << paramTypes[i];
             if (i != paramTypes.size() - 1)
-                std::cout << ",";
+                Destination::stream() << ",";
         }
 
-        std::cout << ")" << std::endl;
-        exit(0);
+        Destination::stream() << ")" << std::endl;
+        throw Aborted();
+    }
+
+    void errorUndef(int lineno, ast::SymbolId id) {
+        errorUndef(lineno, std::string(Destination::names().name(id)));
+    }
+
+    void errorDefAsFunc(int lineno, ast::SymbolId id) {
+        errorDefAsFunc(lineno, std::string(Destination::names().name(id)));
+    }
+
+    void errorUndefFunc(int lineno, ast::SymbolId id) {
+        errorUndefFunc(lineno, std::string(Destination::names().name(id)));
+    }
+
+    void errorDefAsVar(int lineno, ast::SymbolId id) {
+        errorDefAsVar(lineno, std::string(Destination::names().name(id)));
+    }
+
+    void errorDef(int lineno, ast::SymbolId id) {
+        errorDef(lineno, std::string(Destination::names().name(id)));
+    }
+
+    void errorPrototypeMismatch(int lineno, ast::SymbolId id, std::vector<std::string> &paramTypes) {
+        errorPrototypeMismatch(lineno, std::string(Destination::names().name(id)), paramTypes);
     }
 
     void errorUnexpectedBreak(int lineno) {
-        std::cout << "line " << lineno << ":" << " unexpected break statement" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " unexpected break statement" << std::endl;
+        throw Aborted();
     }
 
     void errorUnexpectedContinue(int lineno) {
-        std::cout << "line " << lineno << ":" << " unexpected continue statement" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ":" << " unexpected continue statement" << std::endl;
+        throw Aborted();
     }
 
     void errorMainMissing() {
-        std::cout << "Program has no 'void main()' function" << std::endl;
-        exit(0);
+        Destination::stream() << "Program has no 'void main()' function" << std::endl;
+        throw Aborted();
     }
 
     void errorByteTooLarge(int lineno, const int value) {
-        std::cout << "line " << lineno << ": byte value " << value << " out of range" << std::endl;
-        exit(0);
+        Destination::stream() << "line " << lineno << ": byte value " << value << " out of range" << std::endl;
+        throw Aborted();
     }
 
-    /* ScopePrinter class */
+    /* Chunked output buffer */
 
-    ScopePrinter::ScopePrinter() : indentLevel(0) {}
+    void OutputBuffer::grow(std::size_t n) {
+        if (!chunks.empty()) {
+            chunks.back().size = used(chunks.size() - 1);
+        }
+        std::size_t capacity = std::max(n, CHUNK_SIZE);
+        chunks.push_back({std::unique_ptr<char[]>(new char[capacity]), 0});
+        cur = chunks.back().data.get();
+        end = cur + capacity;
+    }
+
+    std::size_t OutputBuffer::used(std::size_t i) const {
+        return i + 1 == chunks.size() ? static_cast<std::size_t>(cur - chunks[i].data.get()) : chunks[i].size;
+    }
 
-    std::string ScopePrinter::indent() const {
-        std::string result;
-        for (int i = 0; i < indentLevel; ++i) {
-            result += "  ";
+    void OutputBuffer::append(std::string_view text) {
+        while (!text.empty()) {
+            if (cur == end) {
+                grow(text.size());
+            }
+            std::size_t n = std::min(text.size(), static_cast<std::size_t>(end - cur));
+            std::memcpy(cur, text.data(), n);
+            cur += n;
+            text.remove_prefix(n);
         }
-        return result;
     }
 
+    void OutputBuffer::append(int value) {
+        // Sign and ten digits
+        if (end - cur < 11) {
+            grow(11);
+        }
+        cur = std::to_chars(cur, end, value).ptr;
+    }
+
+    std::size_t OutputBuffer::size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            total += used(i);
+        }
+        return total;
+    }
+
+    bool OutputBuffer::writeTo(int fd) const {
+        std::vector<iovec> pending;
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            pending.push_back({chunks[i].data.get(), used(i)});
+        }
+
+        std::size_t first = 0;
+        while (first < pending.size()) {
+            int count = static_cast<int>(std::min<std::size_t>(pending.size() - first, IOV_MAX));
+            ssize_t written = ::writev(fd, &pending[first], count);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            // Skip what was written, which may end in the middle of a chunk
+            std::size_t left = static_cast<std::size_t>(written);
+            while (first < pending.size() && left >= pending[first].iov_len) {
+                left -= pending[first].iov_len;
+                ++first;
+            }
+            if (left > 0) {
+                pending[first].iov_base = static_cast<char *>(pending[first].iov_base) + left;
+                pending[first].iov_len -= left;
+            }
+        }
+        return true;
+    }
+
+    void OutputBuffer::writeTo(std::ostream &os) const {
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            os.write(chunks[i].data.get(), static_cast<std::streamsize>(used(i)));
+        }
+    }
+
+    /* ScopePrinter class */
+
+    ScopePrinter::ScopePrinter(const ast::Interner &names) : names(&names), indentLevel(0), maxIndentLevel(0) {}
+
     void ScopePrinter::beginScope() {
         indentLevel++;
-        buffer << indent() << "---begin scope---" << std::endl;
+        maxIndentLevel = std::max(maxIndentLevel, indentLevel);
+        lines.push_back({Line::BEGIN_SCOPE, ast::BuiltInType::VOID, indentLevel, 0, 0});
     }
 
     void ScopePrinter::endScope() {
-        buffer << indent() << "---end scope---" << std::endl;
+        lines.push_back({Line::END_SCOPE, ast::BuiltInType::VOID, indentLevel, 0, 0});
         indentLevel--;
     }
 
-    void ScopePrinter::emitVar(const std::string &id, const ast::BuiltInType &type, int offset) {
-        buffer << indent() << id << " " << toString(type) << " " << offset << std::endl;
+    void ScopePrinter::emitVar(ast::SymbolId id, const ast::BuiltInType &type, int offset) {
+        lines.push_back({Line::VAR, type, indentLevel, id, offset});
     }
 
-    void ScopePrinter::emitFunc(const std::string &id, const ast::BuiltInType &returnType,
+    void ScopePrinter::emitFunc(ast::SymbolId id, const ast::BuiltInType &returnType,
                                 const std::vector<ast::BuiltInType> &paramTypes) {
-        globalsBuffer << id << " " << "(";
+        funcs.push_back({id, returnType, params.size(), paramTypes.size()});
+        params.insert(params.end(), paramTypes.begin(), paramTypes.end());
+    }
 
-        for (int i = 0; i < paramTypes.size(); ++i) {
-            globalsBuffer << toString(paramTypes[i]);
-            if (i != paramTypes.size() - 1)
-                globalsBuffer << ",";
+    void ScopePrinter::append(const ScopePrinter &fragment) {
+        for (const auto &f: fragment.funcs) {
+            funcs.push_back({f.id, f.returnType, params.size(), f.paramCount});
+            params.insert(params.end(), fragment.params.begin() + f.firstParam,
+                          fragment.params.begin() + f.firstParam + f.paramCount);
+        }
+        for (Line line: fragment.lines) {
+            if (line.kind == Line::TEXT) {
+                texts.push_back(fragment.texts[line.id]);
+                line.id = static_cast<ast::SymbolId>(texts.size() - 1);
+            }
+            lines.push_back(line);
+        }
+        maxIndentLevel = std::max(maxIndentLevel, fragment.maxIndentLevel);
+    }
+
+    void ScopePrinter::appendRendered(std::string scopes) {
+        // Indented already, so at level 0
+        lines.push_back({Line::TEXT, ast::BuiltInType::VOID, 0, static_cast<ast::SymbolId>(texts.size()), 0});
+        texts.push_back(std::move(scopes));
+    }
+
+    void ScopePrinter::render(OutputBuffer &out) const {
+        out.append("---begin global scope---\n");
+        renderFuncs(out);
+        renderScopes(out);
+        out.append("---end global scope---\n");
+    }
+
+    void ScopePrinter::renderFuncs(OutputBuffer &out) const {
+        for (const auto &f: funcs) {
+            out.append(names->name(f.id));
+            out.append(" (");
+            for (std::size_t i = 0; i < f.paramCount; ++i) {
+                if (i != 0) {
+                    out.append(',');
+                }
+                out.append(toString(params[f.firstParam + i]));
+            }
+            out.append(") -> ");
+            out.append(toString(f.returnType));
+            out.append('\n');
         }
+    }
+
+    void ScopePrinter::renderScopes(OutputBuffer &out) const {
+        // Every line's indentation is a prefix of the deepest one
+        const std::string spaces(2 * static_cast<std::size_t>(maxIndentLevel), ' ');
+        const std::string_view indentation(spaces);
 
-        globalsBuffer << ")" << " -> " << toString(returnType) << std::endl;
+        for (const auto &line: lines) {
+            out.append(indentation.substr(0, 2 * static_cast<std::size_t>(line.indentLevel)));
+            switch (line.kind) {
+                case Line::BEGIN_SCOPE:
+                    out.append("---begin scope---\n");
+                    break;
+                case Line::END_SCOPE:
+                    out.append("---end scope---\n");
+                    break;
+                case Line::VAR:
+                    out.append(names->name(line.id));
+                    out.append(' ');
+                    out.append(toString(line.type));
+                    out.append(' ');
+                    out.append(line.offset);
+                    out.append('\n');
+                    break;
+                case Line::TEXT:
+                    out.append(texts[line.id]);
+                    break;
+            }
+        }
     }
 
     std::ostream &operator<<(std::ostream &os, const ScopePrinter &printer) {
-        os << "---begin global scope---" << std::endl;
-        os << printer.globalsBuffer.str();
-        os << printer.buffer.str();
-        os << "---end global scope---" << std::endl;
+        OutputBuffer out;
+        printer.render(out);
+        if (&os == &std::cout) {
+            // Hand the dump straight to the kernel once whatever cout holds is out
+            std::cout.flush();
+            if (!out.writeTo(STDOUT_FILENO)) {
+                os.setstate(std::ios::badbit);
+            }
+        } else {
+            out.writeTo(os);
+        }
         return os;
     }
+
+    /* Scope dump kept in a temporary file */
+
+    SpilledScopes::SpilledScopes() : file(std::tmpfile()) {
+        if (file == nullptr) {
+            throw std::system_error(errno, std::generic_category(), "cannot create a temporary file");
+        }
+        fd = fileno(file);
+    }
+
+    SpilledScopes::~SpilledScopes() {
+        std::fclose(file);
+    }
+
+    void SpilledScopes::put(std::size_t index, const ScopePrinter &fragment) {
+        OutputBuffer out;
+        fragment.renderScopes(out);
+        // The file is only ever appended to, through fd, so its offset is always at size
+        if (!out.writeTo(fd)) {
+            throw std::system_error(errno, std::generic_category(), "cannot write a temporary file");
+        }
+        if (index >= spans.size()) {
+            spans.resize(index + 1, Span{0, 0});
+        }
+        spans[index] = {size, out.size()};
+        size += static_cast<off_t>(out.size());
+    }
+
+    void SpilledScopes::print(std::ostream &os, const ScopePrinter &globals) const {
+        OutputBuffer head;
+        head.append("---begin global scope---\n");
+        globals.renderFuncs(head);
+        head.writeTo(os);
+
+        constexpr std::size_t BLOCK_SIZE = 1 << 20;
+        std::unique_ptr<char[]> block(new char[BLOCK_SIZE]);
+        for (const auto &span: spans) {
+            off_t offset = span.offset;
+            std::size_t left = span.length;
+            while (left > 0) {
+                ssize_t got = ::pread(fd, block.get(), std::min(left, BLOCK_SIZE), offset);
+                if (got < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (got <= 0) {
+                    throw std::system_error(got < 0 ? errno : EIO, std::generic_category(),
+                                            "cannot read a temporary file");
+                }
+                os.write(block.get(), got);
+                offset += got;
+                left -= static_cast<std::size_t>(got);
+            }
+        }
+
+        os << "---end global scope---\n";
+    }
 }
@@ -1,66 +1,236 @@
 #ifndef OUTPUT_HPP
 #define OUTPUT_HPP
 
+#include <cstdio>
 #include <vector>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <memory>
+#include <ostream>
+#include <sys/types.h>
 #include "visitor.hpp"
 #include "nodes.hpp"
 
 namespace output {
+    /* Output destination
+     * Errors and scope dumps are written to the calling thread's current stream (std::cout by default), and
+     * SymbolIds passed to the error functions are spelled with its current interner. A Destination installs both
+     * until it goes out of scope, so several programs can be checked at once on different threads.
+     */
+    class Destination {
+    public:
+        explicit Destination(std::ostream &stream, const ast::Interner *names = nullptr);
+
+        Destination(const Destination &) = delete;
+
+        Destination &operator=(const Destination &) = delete;
+
+        ~Destination();
+
+        // Sets the interner used to spell SymbolIds in error messages
+        void setNames(const ast::Interner *names);
+
+        static std::ostream &stream();
+
+        static const ast::Interner &names();
+
+    private:
+        std::ostream *prevStream;
+        const ast::Interner *prevNames;
+    };
+
+    /* Thrown by every error function once its message is written; ends the compilation of the current program */
+    struct Aborted {
+    };
+
     /* Error handling functions */
 
-    void errorLex(int lineno);
+    [[noreturn]] void errorLex(int lineno);
 
-    void errorSyn(int lineno);
+    [[noreturn]] void errorSyn(int lineno);
 
-    void errorUndef(int lineno, const std::string &id);
+    [[noreturn]] void errorUndef(int lineno, const std::string &id);
 
-    void errorDefAsFunc(int lineno, const std::string &id);
+    [[noreturn]] void errorDefAsFunc(int lineno, const std::string &id);
 
-    void errorUndefFunc(int lineno, const std::string &id);
+    [[noreturn]] void errorUndefFunc(int lineno, const std::string &id);
 
-    void errorDefAsVar(int lineno, const std::string &id);
+    [[noreturn]] void errorDefAsVar(int lineno, const std::string &id);
 
-    void errorDef(int lineno, const std::string &id);
+    [[noreturn]] void errorDef(int lineno, const std::string &id);
 
-    void errorPrototypeMismatch(int lineno, const std::string &id, std::vector<std::string> &paramTypes);
+    [[noreturn]] void errorPrototypeMismatch(int lineno, const std::string &id, std::vector<std::string> &paramTypes);
 
-    void errorMismatch(int lineno);
+    /* Overloads for interned identifiers; the spelling is resolved only when the error is printed */
 
-    void errorUnexpectedBreak(int lineno);
+    [[noreturn]] void errorUndef(int lineno, ast::SymbolId id);
+
+    [[noreturn]] void errorDefAsFunc(int lineno, ast::SymbolId id);
+
+    [[noreturn]] void errorUndefFunc(int lineno, ast::SymbolId id);
+
+    [[noreturn]] void errorDefAsVar(int lineno, ast::SymbolId id);
+
+    [[noreturn]] void errorDef(int lineno, ast::SymbolId id);
+
+    [[noreturn]] void errorPrototypeMismatch(int lineno, ast::SymbolId id, std::vector<std::string> &paramTypes);
+
+    [[noreturn]] void errorMismatch(int lineno);
+
+    [[noreturn]] void errorUnexpectedBreak(int lineno);
+
+    [[noreturn]] void errorUnexpectedContinue(int lineno);
+
+    [[noreturn]] void errorMainMissing();
+
+    [[noreturn]] void errorByteTooLarge(int lineno, int value);
+
+    /* Chunked output buffer
+     * Text is appended to fixed-size chunks that are never moved or copied once filled, and the whole buffer is
+     * handed to the kernel in one writev() call per IOV_MAX chunks.
+     */
+    class OutputBuffer {
+    public:
+        void append(std::string_view text);
 
-    void errorUnexpectedContinue(int lineno);
+        void append(char c) {
+            if (cur == end) {
+                grow(1);
+            }
+            *cur++ = c;
+        }
 
-    void errorMainMissing();
+        // Appends the decimal representation of value
+        void append(int value);
 
-    void errorByteTooLarge(int lineno, int value);
+        // Total number of bytes appended
+        std::size_t size() const;
+
+        // Writes everything to the file descriptor; returns false if the write failed
+        bool writeTo(int fd) const;
+
+        // Writes everything to os, for destinations that are not a file descriptor
+        void writeTo(std::ostream &os) const;
+
+    private:
+        static constexpr std::size_t CHUNK_SIZE = 1 << 20;
+
+        struct Chunk {
+            std::unique_ptr<char[]> data;
+            // Bytes used, set when the next chunk is started
+            std::size_t size;
+        };
+
+        std::vector<Chunk> chunks;
+        char *cur = nullptr;
+        char *end = nullptr;
+
+        // Starts a chunk with room for at least n bytes
+        void grow(std::size_t n);
+
+        // Bytes used in chunk i
+        std::size_t used(std::size_t i) const;
+    };
 
     /* ScopePrinter class
      * This class is used to print scopes in a human-readable format.
+     * Lines are recorded as compact entries holding interned ids and are only rendered to text when printed.
      */
     class ScopePrinter {
     private:
-        std::stringstream globalsBuffer;
-        std::stringstream buffer;
+        struct Func {
+            ast::SymbolId id;
+            ast::BuiltInType returnType;
+            // Range of this function's parameter types in params
+            std::size_t firstParam;
+            std::size_t paramCount;
+        };
+
+        struct Line {
+            // A TEXT line is texts[id], already rendered
+            enum Kind : unsigned char {
+                BEGIN_SCOPE, END_SCOPE, VAR, TEXT
+            };
+
+            Kind kind;
+            ast::BuiltInType type;
+            int indentLevel;
+            ast::SymbolId id;
+            int offset;
+        };
+
+        const ast::Interner *names;
+        std::vector<Func> funcs;
+        std::vector<ast::BuiltInType> params;
+        std::vector<Line> lines;
+        std::vector<std::string> texts;
         int indentLevel;
-
-        std::string indent() const;
+        // Deepest indentLevel recorded, so rendering can build its indentation once
+        int maxIndentLevel;
 
     public:
-        ScopePrinter();
+        explicit ScopePrinter(const ast::Interner &names);
 
         void beginScope();
 
         void endScope();
 
-        void emitVar(const std::string &id, const ast::BuiltInType &type, int offset);
+        void emitVar(ast::SymbolId id, const ast::BuiltInType &type, int offset);
 
-        void emitFunc(const std::string &id, const ast::BuiltInType &returnType,
+        void emitFunc(ast::SymbolId id, const ast::BuiltInType &returnType,
                       const std::vector<ast::BuiltInType> &paramTypes);
 
+        // Appends the scopes recorded by fragment, a printer that started at the same nesting level as this one
+        void append(const ScopePrinter &fragment);
+
+        // Appends scopes rendered by renderScopes() of a printer that started at the same nesting level as this one
+        void appendRendered(std::string scopes);
+
+        // Renders the whole scope dump into out
+        void render(OutputBuffer &out) const;
+
+        // Renders only the functions of the global scope, one per line
+        void renderFuncs(OutputBuffer &out) const;
+
+        // Renders only the scopes nested in the global scope
+        void renderScopes(OutputBuffer &out) const;
+
         friend std::ostream &operator<<(std::ostream &os, const ScopePrinter &printer);
     };
+
+    /* Scope dump kept in a temporary file
+     * The scopes of each function are rendered as soon as it is analyzed and written out of memory, so the dump of a
+     * program of any length takes no more memory than its largest function. Functions may be put in any order, and
+     * again to replace what they had.
+     */
+    class SpilledScopes {
+    public:
+        SpilledScopes();
+
+        SpilledScopes(const SpilledScopes &) = delete;
+
+        SpilledScopes &operator=(const SpilledScopes &) = delete;
+
+        ~SpilledScopes();
+
+        // Stores the scopes recorded by fragment as those of the index-th function
+        void put(std::size_t index, const ScopePrinter &fragment);
+
+        // Writes the whole dump to os: the global scope with the functions recorded by globals, then the scopes of
+        // every function, by index
+        void print(std::ostream &os, const ScopePrinter &globals) const;
+
+    private:
+        struct Span {
+            off_t offset;
+            std::size_t length;
+        };
+
+        std::FILE *file;
+        int fd;
+        off_t size = 0;
+        std::vector<Span> spans;
+    };
 }
 
 #endif //OUTPUT_HPP
@@ -2,24 +2,322 @@
 
 #include "nodes.hpp"
 #include "output.hpp"
-
-extern int yylineno;
-extern int yylex();
-
-void yyerror(const char*);
-
-std::shared_ptr<ast::Node> program;
+#include "frontend.hpp"
 
 using namespace std;
 
 // TODO: Place any additional declarations here
 %}
-%define api.value.type {std::shared_ptr<ast::Node>}
+
+%code requires {
+#include "nodes.hpp"
+
+typedef void *yyscan_t;
+struct ParseContext;
+}
+
+// No globals: the program being built and its scanner are threaded through yyparse and yylex
+%define api.pure full
+%param {ParseContext *context}
+
+// Every semantic value is a node pointer typed by what the rule builds, so actions never need a downcast
+%union {
+    ast::Exp *exp;
+    ast::ID *id;
+    ast::Call *call;
+    ast::ExpList *expList;
+    ast::Type *type;
+    ast::Statement *statement;
+    ast::Statements *statements;
+    ast::Formal *formal;
+    ast::Formals *formals;
+    ast::FuncDecl *funcDecl;
+    ast::Funcs *funcs;
+}
+
+%code {
+#include "SimdScanner.hpp"
+#include "SpscRing.hpp"
+#include "TokenArray.hpp"
+#include "Trace.hpp"
+
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Reentrant scanner generated by flex from scanner.lex, whose YY_DECL names it flexLex
+struct yy_buffer_state;
+int flexLex(YYSTYPE *yylval, yyscan_t scanner);
+int yylex_init_extra(ParsedProgram *program, yyscan_t *scanner);
+int yylex_destroy(yyscan_t scanner);
+yy_buffer_state *yy_scan_buffer(char *base, size_t size, yyscan_t scanner);
+int yyget_lineno(yyscan_t scanner);
+void yyset_lineno(int line, yyscan_t scanner);
+
+/* The program being built and the scanner reading its source */
+struct ParseContext {
+    // A token handed from the lexer thread to the parser, with the line the scanner was at after it
+    struct LexedToken {
+        int token;
+        int line;
+        YYSTYPE value;
+    };
+
+    // Pushed by the lexer thread when the scanner threw something other than a lexical error
+    static constexpr int LEXER_FAILED = -2;
+    // Tokens in flight between the lexer thread and the parser
+    static constexpr std::size_t RING_CAPACITY = 4096;
+    // Text that parseStreaming has finished with is released in steps of this many bytes
+    static constexpr std::ptrdiff_t RELEASE_STEP = 1 << 20;
+
+    ParsedProgram &program;
+    ScannerKind scanner;
+    // Exactly one backend is set up
+    yyscan_t flex = nullptr;
+    std::optional<SimdScanner> simd;
+    TokenArray prelexed;
+    std::size_t nextToken = 0;
+    // Line of the last token handed to the parser, for the backends that run ahead of it
+    int consumedLine = 1;
+    // Set by parseHeaders: function bodies are skipped and come as a single BODY token
+    bool skipBodies = false;
+    // The last token returned was BODY, whose { was on bodyLine
+    bool lastWasBody = false;
+    int bodyLine = 0;
+    // First token to return, before any from the scanner (START_BODY for parseBody, START_FUNC for parseFunction),
+    // and what is parsed after it
+    int startToken = 0;
+    ast::Statements *body = nullptr;
+    ast::FuncDecl *function = nullptr;
+    // Set by parseStreaming: functions go to sink as they are reduced, and their text is recorded in
+    // program.functions. functionStart and functionLine are where the text of the next function starts, and
+    // braceDepth is the nesting of the braces returned so far
+    FunctionSink *sink = nullptr;
+    std::size_t functionCount = 0;
+    const char *functionStart = nullptr;
+    int functionLine = 1;
+    int braceDepth = 0;
+    // Text before released has been handed back to the kernel
+    const char *released = nullptr;
+    // Arena state before the function being parsed, which streamed() rewinds to
+    ast::Arena::Mark nodesMark{};
+    ast::Arena::Mark tokensMark{};
+    // Set up with --pipeline: the flex or SIMD backend runs on lexer, which feeds the parser through ring
+    std::unique_ptr<SpscRing<LexedToken>> ring;
+    std::thread lexer;
+    std::atomic<bool> parserDone{false};
+    std::exception_ptr lexerFailure;
+
+    ParseContext(ParsedProgram &program, ScannerKind scanner, unsigned jobs, bool pipeline = false)
+            : program(program), scanner(scanner) {
+        if (scanner == ScannerKind::Prelex && program.source.size() > TokenArray::MAX_SOURCE) {
+            this->scanner = scanner = ScannerKind::Simd;
+        }
+        switch (scanner) {
+            case ScannerKind::Flex:
+                yylex_init_extra(&program, &flex);
+                // Scan the text where it is, including the two NUL bytes that end it
+                yy_scan_buffer(program.source.data(), program.source.size() + 2, flex);
+                yyset_lineno(1, flex);
+                break;
+            case ScannerKind::Simd:
+                simd.emplace(program);
+                break;
+            case ScannerKind::Prelex:
+                // Everything is lexed before the parser starts, so there is nothing to overlap
+                prelexed = TokenArray::lex(program.source, jobs);
+                pipeline = false;
+                break;
+        }
+        if (pipeline) {
+            ring = std::make_unique<SpscRing<LexedToken>>(RING_CAPACITY);
+            lexer = std::thread([this] { produce(); });
+        }
+    }
+
+    // Context for parsing one span recorded by a first parse, starting with startToken
+    ParseContext(ParsedProgram &program, const SourceSpan &span, int startToken)
+            : program(program), scanner(ScannerKind::Simd), startToken(startToken) {
+        simd.emplace(program, span.begin, span.begin + span.length, span.line);
+    }
+
+    ParseContext(const ParseContext &) = delete;
+
+    ParseContext &operator=(const ParseContext &) = delete;
+
+    ~ParseContext() {
+        if (lexer.joinable()) {
+            // The parser may have stopped early, on a syntax error, with the lexer waiting for room in the ring
+            parserDone.store(true, std::memory_order_relaxed);
+            lexer.join();
+        }
+        if (flex) {
+            yylex_destroy(flex);
+        }
+    }
+
+    int lex(YYSTYPE *value) {
+        if (ring) {
+            LexedToken lexed = ring->pop();
+            consumedLine = lexed.line;
+            if (lexed.token == SimdScanner::LEXICAL_ERROR) {
+                output::errorLex(consumedLine);
+            }
+            if (lexed.token == LEXER_FAILED) {
+                std::rethrow_exception(lexerFailure);
+            }
+            *value = lexed.value;
+            return lexed.token;
+        }
+        if (startToken) {
+            return std::exchange(startToken, 0);
+        }
+        if (skipBodies) {
+            return nextSkippingBodies(value);
+        }
+        if (sink) {
+            return nextRecordingFunctions(value);
+        }
+        switch (scanner) {
+            case ScannerKind::Flex:
+                return flexLex(value, flex);
+            case ScannerKind::Simd:
+                return simd->next(*value);
+            case ScannerKind::Prelex:
+                break;
+        }
+        if (nextToken == prelexed.size()) {
+            consumedLine = prelexed.endLine;
+            return 0;
+        }
+        std::size_t i = nextToken++;
+        int token = prelexed.kinds[i];
+        consumedLine = prelexed.lines[i];
+        if (token == SimdScanner::LEXICAL_ERROR) {
+            output::errorLex(consumedLine);
+        }
+        std::string_view text(program.source.data() + prelexed.offsets[i], prelexed.lengths[i]);
+        SimdScanner::makeValue(program, token, text, consumedLine, *value);
+        return token;
+    }
+
+    // Hands a function that was just reduced to sink, then frees it unless the parser already holds the token after
+    // it (which it does not need to reduce a function, so only before a syntax error)
+    void streamed(ast::FuncDecl *decl, bool lookahead) {
+        sink->function(functionCount++, *decl);
+        if (!lookahead) {
+            program.arena.rewind(nodesMark);
+            program.tokenArena.rewind(tokensMark);
+        }
+    }
+
+    // Line the scanner has reached, as far as the parser has seen
+    int line() const {
+        if (ring) {
+            return consumedLine;
+        }
+        return scannerLine();
+    }
+
+private:
+    // Every { outside a body starts one, so the scanner skips to the matching }
+    int nextSkippingBodies(YYSTYPE *value) {
+        int token = simd->next(*value);
+        lastWasBody = token == LBRACE;
+        if (lastWasBody) {
+            bodyLine = simd->line();
+            std::string_view text = simd->skipBlock();
+            program.bodies.push_back({text.data(), text.size(), bodyLine});
+            token = BODY;
+        }
+        return token;
+    }
+
+    // A } that closes every open brace ends a function
+    int nextRecordingFunctions(YYSTYPE *value) {
+        int token = simd->next(*value);
+        if (token == LBRACE) {
+            ++braceDepth;
+        } else if (token == RBRACE && braceDepth > 0 && --braceDepth == 0) {
+            const char *end = simd->position();
+            program.functions.push_back({functionStart, static_cast<std::size_t>(end - functionStart), functionLine});
+            functionStart = end;
+            functionLine = simd->line();
+            if (functionStart - released >= RELEASE_STEP) {
+                program.source.release(functionStart);
+                released = functionStart;
+            }
+        }
+        return token;
+    }
+
+    int scannerLine() const {
+        switch (scanner) {
+            case ScannerKind::Flex:
+                return yyget_lineno(flex);
+            case ScannerKind::Simd:
+                return simd->line();
+            case ScannerKind::Prelex:
+                break;
+        }
+        return consumedLine;
+    }
+
+    // Body of the lexer thread. The scanner builds its nodes in the program's tokenArena and is the only user of
+    // its interner until the parse ends, so it shares nothing with the parser but the ring. A lexical error is
+    // passed on as a token rather than reported here, so that it comes out after any syntax error before it.
+    void produce() {
+        trace::Span span("lex");
+        std::ostream discard(nullptr);
+        output::Destination quiet(discard);
+        YYSTYPE value{};
+        int token;
+        try {
+            do {
+                token = scanner == ScannerKind::Flex ? flexLex(&value, flex) : simd->next(value);
+                if (!ring->push({token, scannerLine(), value}, parserDone)) {
+                    return;
+                }
+            } while (token != 0);
+        } catch (const output::Aborted &) {
+            ring->push({SimdScanner::LEXICAL_ERROR, scannerLine(), {}}, parserDone);
+        } catch (...) {
+            lexerFailure = std::current_exception();
+            ring->push({LEXER_FAILED, scannerLine(), {}}, parserDone);
+        }
+    }
+};
+
+static int yylex(YYSTYPE *value, ParseContext *context) {
+    return context->lex(value);
+}
+
+void yyerror(ParseContext *context, const char*);
+
+// Builds a node of the program being parsed, stamped with the line the scanner has reached
+template<typename T, typename... Args>
+static T *make(ParseContext *context, Args &&... args) {
+    return context->program.make<T>(context->line(), std::forward<Args>(args)...);
+}
+
+// Arena of the program being parsed, for growing its lists
+static ast::Arena &arena(ParseContext *context) {
+    return context->program.arena;
+}
+}
+
 // TODO: Define tokens here
 
 %token VOID INT BYTE BOOL AND OR NOT TRUE FALSE RETURN IF ELSE WHILE BREAK CONTINUE
 %token SC COMMA LPAREN RPAREN LBRACE RBRACE LBRACK RBRACK ASSIGN COMMENT
-%token ID NUM NUM_B STRING
+// Only with lazy parsing: a skipped function body, and the token that starts the parse of one
+%token BODY START_BODY
+// Starts the parse of one function recorded by parseStreaming
+%token START_FUNC
+%token <id> ID
+%token <exp> NUM NUM_B STRING
 %token ADD
 %token SUB
 %token MUL
@@ -31,6 +329,17 @@ using namespace std;
 %token LE
 %token GE
 
+%type <funcs> Funcs
+%type <funcDecl> FuncDecl
+%type <type> RetType Type
+%type <formals> Formals FormalsList
+%type <formal> FormalDecl
+%type <statements> Statements
+%type <statement> Statement
+%type <call> Call
+%type <expList> ExpList
+%type <exp> Exp
+
 // TODO: Define precedence and associativity here
 
 %nonassoc LOWER_THAN_ELSE
@@ -43,178 +352,142 @@ using namespace std;
 %left MUL DIV
 %right NOT
 
-%start Program
+%start Input
 
 %%
 
-Program: Funcs { program = $1; }
+Input: Program
+     | START_BODY Statements RBRACE { context->body = $2; }
+     | START_FUNC FuncDecl { context->function = $2; }
+;
+
+Program: Funcs { context->program.funcs = $1; }
 ;
 
 // TODO: Define grammar here
 
+// When streaming, functions are not kept, so there is no list
 Funcs:
-    { $$ = std::make_shared<ast::Funcs>(); }
-  | FuncDecl Funcs
+    { $$ = context->sink ? nullptr : make<ast::Funcs>(context); }
+  | Funcs FuncDecl
     {
-        auto funcs = std::dynamic_pointer_cast<ast::Funcs>($2);
-        auto f = std::dynamic_pointer_cast<ast::FuncDecl>($1);
-        funcs->push_front(f);
-        $$ = funcs;
+        if (context->sink) {
+            context->streamed($2, yychar != YYEMPTY);
+        } else {
+            $1->push_back(arena(context), $2);
+        }
+        $$ = $1;
     }
 ;
 
 
 FuncDecl: RetType ID LPAREN Formals RPAREN LBRACE Statements RBRACE
-    { $$ = std::make_shared<ast::FuncDecl>(
-        std::dynamic_pointer_cast<ast::ID>($2),
-        std::dynamic_pointer_cast<ast::Type>($1),
-        std::dynamic_pointer_cast<ast::Formals>($4),
-        std::dynamic_pointer_cast<ast::Statements>($7)
-    ); }
+    { $$ = make<ast::FuncDecl>(context, $2, $1, $4, $7); }
+        | RetType ID LPAREN Formals RPAREN BODY
+    { $$ = make<ast::FuncDecl>(context, $2, $1, $4, nullptr); }
 ;
 
 RetType: Type { $$ = $1; }
-       | VOID { $$ = std::make_shared<ast::Type>(ast::BuiltInType::VOID); }
+       | VOID { $$ = make<ast::Type>(context, ast::BuiltInType::VOID); }
 ;
 
-Formals: { $$ = std::make_shared<ast::Formals>(); }
+Formals: { $$ = make<ast::Formals>(context); }
        | FormalsList { $$ = $1; }
 ;
 
 FormalsList:
     FormalDecl
     {
-        auto f = std::dynamic_pointer_cast<ast::Formal>($1);
-        $$ = std::make_shared<ast::Formals>(f);
+        $$ = make<ast::Formals>(context);
+        $$->push_back(arena(context), $1);
     }
-  | FormalDecl COMMA FormalsList
+  | FormalsList COMMA FormalDecl
     {
-        auto f = std::dynamic_pointer_cast<ast::Formal>($1);
-        auto list = std::dynamic_pointer_cast<ast::Formals>($3);
-        list->push_front(f);
-        $$ = list;
+        $1->push_back(arena(context), $3);
+        $$ = $1;
     }
 ;
 
 
 FormalDecl: Type ID
-    { $$ = std::make_shared<ast::Formal>(
-        std::dynamic_pointer_cast<ast::ID>($2),
-        std::dynamic_pointer_cast<ast::Type>($1)
-    ); }
+    { $$ = make<ast::Formal>(context, $2, $1); }
 ;
 
 Statements: Statement
     {
-        auto list = std::make_shared<ast::Statements>();
-        auto s = std::dynamic_pointer_cast<ast::Statement>($1);
-        list->push_back(s);
-        $$ = list;
+        $$ = make<ast::Statements>(context);
+        $$->push_back(arena(context), $1);
     }
     | Statements Statement
     {
-        auto list = std::dynamic_pointer_cast<ast::Statements>($1);
-        auto s = std::dynamic_pointer_cast<ast::Statement>($2);
-        list->push_back(s);
-        $$ = list;
+        $1->push_back(arena(context), $2);
+        $$ = $1;
     }
 ;
 
 
 Statement: LBRACE Statements RBRACE
-    { $$ = std::dynamic_pointer_cast<ast::Statements>($2); }
+    { $$ = $2; }
          | Type ID SC
-    { auto t = std::dynamic_pointer_cast<ast::Type>($1);
-      auto id = std::dynamic_pointer_cast<ast::ID>($2);
-      $$ = std::make_shared<ast::VarDecl>(id, t, nullptr); }
+    { $$ = make<ast::VarDecl>(context, $2, $1, nullptr); }
          | Type ID ASSIGN Exp SC
-    { auto t = std::dynamic_pointer_cast<ast::Type>($1);
-      auto id = std::dynamic_pointer_cast<ast::ID>($2);
-      auto exp = std::dynamic_pointer_cast<ast::Exp>($4);
-      $$ = std::make_shared<ast::VarDecl>(id, t, exp); }
+    { $$ = make<ast::VarDecl>(context, $2, $1, $4); }
          | ID ASSIGN Exp SC
-    { auto id = std::dynamic_pointer_cast<ast::ID>($1);
-      auto exp = std::dynamic_pointer_cast<ast::Exp>($3);
-      $$ = std::make_shared<ast::Assign>(id, exp); }
+    { $$ = make<ast::Assign>(context, $1, $3); }
          | Call SC
-    { $$ = std::dynamic_pointer_cast<ast::Statement>($1); }
+    { $$ = $1; }
          | RETURN SC
-    { $$ = std::make_shared<ast::Return>(nullptr); }
+    { $$ = make<ast::Return>(context, nullptr); }
          | RETURN Exp SC
-    { auto exp = std::dynamic_pointer_cast<ast::Exp>($2);
-      $$ = std::make_shared<ast::Return>(exp); }
+    { $$ = make<ast::Return>(context, $2); }
          | IF LPAREN Exp RPAREN Statement %prec LOWER_THAN_ELSE
-    { auto cond = std::dynamic_pointer_cast<ast::Exp>($3);
-      auto then_s = std::dynamic_pointer_cast<ast::Statement>($5);
-      $$ = std::make_shared<ast::If>(cond, then_s, nullptr); }
+    { $$ = make<ast::If>(context, $3, $5, nullptr); }
          | IF LPAREN Exp RPAREN Statement ELSE Statement
-    { auto cond = std::dynamic_pointer_cast<ast::Exp>($3);
-      auto then_s = std::dynamic_pointer_cast<ast::Statement>($5);
-      auto else_s = std::dynamic_pointer_cast<ast::Statement>($7);
-      $$ = std::make_shared<ast::If>(cond, then_s, else_s); }
+    { $$ = make<ast::If>(context, $3, $5, $7); }
          | WHILE LPAREN Exp RPAREN Statement
-    { auto cond = std::dynamic_pointer_cast<ast::Exp>($3);
-      auto body = std::dynamic_pointer_cast<ast::Statement>($5);
-      $$ = std::make_shared<ast::While>(cond, body); }
+    { $$ = make<ast::While>(context, $3, $5); }
          | BREAK SC
-    { $$ = std::make_shared<ast::Break>(); }
+    { $$ = make<ast::Break>(context); }
          | CONTINUE SC
-    { $$ = std::make_shared<ast::Continue>(); }
+    { $$ = make<ast::Continue>(context); }
 ;
 
 Call: ID LPAREN ExpList RPAREN
-    { auto id = std::dynamic_pointer_cast<ast::ID>($1);
-      auto args = std::dynamic_pointer_cast<ast::ExpList>($3);
-      $$ = std::make_shared<ast::Call>(id, args); }
+    { $$ = make<ast::Call>(context, $1, $3); }
     | ID LPAREN RPAREN
-    { auto id = std::dynamic_pointer_cast<ast::ID>($1);
-      $$ = std::make_shared<ast::Call>(id); }
+    { $$ = make<ast::Call>(context, $1, make<ast::ExpList>(context)); }
 ;
 
 ExpList: Exp
-    { auto e = std::dynamic_pointer_cast<ast::Exp>($1);
-      $$ = std::make_shared<ast::ExpList>(e); }
-       | Exp COMMA ExpList
-    { auto e = std::dynamic_pointer_cast<ast::Exp>($1);
-      auto list = std::dynamic_pointer_cast<ast::ExpList>($3);
-      list->push_front(e);
-      $$ = list; }
+    {
+        $$ = make<ast::ExpList>(context);
+        $$->push_back(arena(context), $1);
+    }
+       | ExpList COMMA Exp
+    {
+        $1->push_back(arena(context), $3);
+        $$ = $1;
+    }
 ;
 
 Type: INT
-    { $$ = std::make_shared<ast::Type>(ast::BuiltInType::INT); }
+    { $$ = make<ast::Type>(context, ast::BuiltInType::INT); }
     | BYTE
-    { $$ = std::make_shared<ast::Type>(ast::BuiltInType::BYTE); }
+    { $$ = make<ast::Type>(context, ast::BuiltInType::BYTE); }
     | BOOL
-    { $$ = std::make_shared<ast::Type>(ast::BuiltInType::BOOL); }
+    { $$ = make<ast::Type>(context, ast::BuiltInType::BOOL); }
 ;
 
 Exp: LPAREN Exp RPAREN 
     { $$ = $2; }
    | Exp ADD Exp
-    { $$ = std::make_shared<ast::BinOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::BinOpType::ADD
-    ); }
+    { $$ = make<ast::BinOp>(context, $1, $3, ast::BinOpType::ADD); }
    | Exp SUB Exp
-    { $$ = std::make_shared<ast::BinOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::BinOpType::SUB
-    ); }
+    { $$ = make<ast::BinOp>(context, $1, $3, ast::BinOpType::SUB); }
    | Exp MUL Exp
-    { $$ = std::make_shared<ast::BinOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::BinOpType::MUL
-    ); }
+    { $$ = make<ast::BinOp>(context, $1, $3, ast::BinOpType::MUL); }
    | Exp DIV Exp
-    { $$ = std::make_shared<ast::BinOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::BinOpType::DIV
-    ); }
+    { $$ = make<ast::BinOp>(context, $1, $3, ast::BinOpType::DIV); }
    | ID
     { $$ = $1; }
    | Call
@@ -226,72 +499,117 @@ Exp: LPAREN Exp RPAREN
    | STRING
     { $$ = $1; }
    | TRUE
-    { $$ = std::make_shared<ast::Bool>(true); }
+    { $$ = make<ast::Bool>(context, true); }
    | FALSE
-    { $$ = std::make_shared<ast::Bool>(false); }
+    { $$ = make<ast::Bool>(context, false); }
    | NOT Exp
-    { $$ = std::make_shared<ast::Not>(
-        std::dynamic_pointer_cast<ast::Exp>($2)
-    ); }
+    { $$ = make<ast::Not>(context, $2); }
    | Exp AND Exp
-    { $$ = std::make_shared<ast::And>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3)
-    ); }
+    { $$ = make<ast::And>(context, $1, $3); }
    | Exp OR Exp
-    { $$ = std::make_shared<ast::Or>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3)
-    ); }
+    { $$ = make<ast::Or>(context, $1, $3); }
    | Exp EQ Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::EQ
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::EQ); }
    | Exp NE Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::NE
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::NE); }
    | Exp LT Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::LT
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::LT); }
    | Exp GT Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::GT
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::GT); }
    | Exp LE Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::LE
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::LE); }
    | Exp GE Exp
-    { $$ = std::make_shared<ast::RelOp>(
-        std::dynamic_pointer_cast<ast::Exp>($1),
-        std::dynamic_pointer_cast<ast::Exp>($3),
-        ast::RelOpType::GE
-    ); }
+    { $$ = make<ast::RelOp>(context, $1, $3, ast::RelOpType::GE); }
    | LPAREN Type RPAREN Exp %prec NOT
-    { $$ = std::make_shared<ast::Cast>(
-        std::dynamic_pointer_cast<ast::Exp>($4),
-        std::dynamic_pointer_cast<ast::Type>($2)
-    ); }
+    { $$ = make<ast::Cast>(context, $4, $2); }
 ;
 
 %%
 
 // TODO: Place any additional code here
-#include <cstdlib>
 
-void yyerror(const char* msg) {
-    output::errorSyn(yylineno);
-    std::exit(0);
+void yyerror(ParseContext *context, const char*) {
+    if (context->lastWasBody) {
+        // A full parse would have stopped at the body's {, before anything in it
+        context->program.bodies.pop_back();
+        output::errorSyn(context->bodyLine);
+    }
+    output::errorSyn(context->line());
+}
+
+std::unique_ptr<ParsedProgram> parseProgram(Source source, ScannerKind scanner, unsigned jobs, bool pipeline) {
+    auto result = std::make_unique<ParsedProgram>();
+    result->source = std::move(source);
+
+    trace::Span span("parse");
+    ParseContext context(*result, scanner, jobs, pipeline);
+    yyparse(&context);
+    return result;
+}
+
+void parseHeaders(ParsedProgram &program) {
+    trace::Span span("parse headers");
+    ParseContext context(program, ScannerKind::Simd, 1);
+    context.skipBodies = true;
+    yyparse(&context);
+}
+
+ast::Statements *parseBody(ParsedProgram &program, std::size_t index) {
+    trace::Span span("parse body", {}, program.bodies[index].line);
+    ParseContext context(program, program.bodies[index], START_BODY);
+    yyparse(&context);
+    return context.body;
+}
+
+void parseStreaming(ParsedProgram &program, FunctionSink &sink) {
+    trace::Span span("parse");
+    ParseContext context(program, ScannerKind::Simd, 1);
+    context.sink = &sink;
+    context.functionStart = context.released = program.source.data();
+    context.nodesMark = program.arena.mark();
+    context.tokensMark = program.tokenArena.mark();
+    yyparse(&context);
+}
+
+ast::FuncDecl *parseFunction(ParsedProgram &program, std::size_t index) {
+    trace::Span span("parse function", {}, program.functions[index].line);
+    ParseContext context(program, program.functions[index], START_FUNC);
+    yyparse(&context);
+    return context.function;
+}
+
+std::unique_ptr<ParsedProgram> parseProgram(const char *buf, size_t len) {
+    return parseProgram(Source::copy(buf, len));
+}
+
+std::size_t scanProgram(Source source, ScannerKind scanner, unsigned jobs, bool pipeline, std::ostream *tokens) {
+    ParsedProgram program;
+    program.source = std::move(source);
+
+    ParseContext context(program, scanner, jobs, pipeline);
+    std::size_t count = 0;
+    YYSTYPE value;
+    while (int token = context.lex(&value)) {
+        ++count;
+        if (!tokens) {
+            continue;
+        }
+        *tokens << context.line() << " " << token;
+        switch (token) {
+            case ID:
+                *tokens << " " << program.names.name(value.id->value);
+                break;
+            case NUM:
+                *tokens << " " << static_cast<ast::Num *>(value.exp)->value;
+                break;
+            case NUM_B:
+                *tokens << " " << static_cast<ast::NumB *>(value.exp)->value;
+                break;
+            case STRING:
+                *tokens << " \"" << static_cast<ast::String *>(value.exp)->value() << "\"";
+                break;
+        }
+        *tokens << "\n";
+    }
+    return count;
 }
@@ -0,0 +1,80 @@
+#!/bin/bash
+
+# Checks that parsing scales linearly with the number of functions and
+# with the length of argument/parameter lists.
+# Usage: ./scaling-test.sh [max_funcs]   (default: 100000)
+
+EXECUTABLE="./hw3"
+MAX_FUNCS=${1:-100000}
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -f "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Writes a program with $1 functions, each taking $2 parameters and
+# calling the previous function with $2 arguments.
+generate() {
+    awk -v n="$1" -v p="$2" 'BEGIN {
+        for (i = 0; i < n; i++) {
+            printf "int f%d(", i
+            for (j = 0; j < p; j++) printf "%sint a%d", (j ? ", " : ""), j
+            printf ") {\n"
+            if (i > 0) {
+                printf "    return f%d(", i - 1
+                for (j = 0; j < p; j++) printf "%sa%d", (j ? ", " : ""), j
+                printf ");\n"
+            } else {
+                printf "    return 0;\n"
+            }
+            printf "}\n"
+        }
+        printf "void main() {\n    printi(1);\n}\n"
+    }'
+}
+
+# Runs hw3 on $1 and prints the elapsed time in milliseconds.
+run_timed() {
+    local start end
+    start=$(date +%s%N)
+    "$EXECUTABLE" < "$1" > "${1%.in}.res"
+    end=$(date +%s%N)
+    echo $(( (end - start) / 1000000 ))
+}
+
+check() {
+    local label=$1 small=$2 large=$3 params=$4
+    generate "$small" "$params" > "$WORK_DIR/small.in"
+    generate "$large" "$params" > "$WORK_DIR/large.in"
+
+    local t_small t_large
+    t_small=$(run_timed "$WORK_DIR/small.in")
+    t_large=$(run_timed "$WORK_DIR/large.in")
+
+    # Every function appears in the global scope, so a truncated or failed
+    # parse shows up as a wrong line count.
+    local funcs
+    funcs=$(grep -c -- '->' "$WORK_DIR/large.res")
+    if [ "$funcs" -ne $((large + 3)) ]; then
+        echo -e "    \033[1;31mFAIL\033[0m - $label: expected $((large + 3)) functions, got $funcs"
+        head -n 3 "$WORK_DIR/large.res"
+        return 1
+    fi
+
+    # Linear growth gives a ratio equal to large/small; allow 2x slack for noise.
+    local limit=$(( 2 * large / small * (t_small > 10 ? t_small : 10) ))
+    if [ "$t_large" -le "$limit" ]; then
+        echo -e "    \033[1;32mPASS\033[0m - $label: ${small} in ${t_small}ms, ${large} in ${t_large}ms"
+        return 0
+    fi
+    echo -e "    \033[1;31mFAIL\033[0m - $label: ${small} in ${t_small}ms, ${large} in ${t_large}ms (limit ${limit}ms)"
+    return 1
+}
+
+status=0
+check "many functions" $((MAX_FUNCS / 4)) "$MAX_FUNCS" 1 || status=1
+check "long parameter lists" 250 1000 200 || status=1
+exit $status
@@ -0,0 +1,177 @@
+#!/bin/bash
+
+# Differential test of the scanner backends: for every tests/*.in, and for
+# variants of them with bytes deleted, duplicated or replaced, the SIMD
+# scanner must produce the same token list (lines, codes and values) and the
+# same hw3 output as the flex scanner. Every SIMD kernel width is checked,
+# streaming, pre-lexed ahead of the parser and on a lexer thread of its own;
+# flex is also run on a lexer thread. Lazy parsing, which skips function
+# bodies by brace matching and parses them later, and streaming analysis,
+# which analyzes each function as soon as it is parsed, must print the same
+# too, as must the analysis cache, both when it is filled and when it is
+# read back, the analysis of the program's AST image once loaded back, and
+# a run that records a trace of every scope. Entries of the cache must not be
+# used once a global collides with a parameter, or once cut short. A large
+# generated program, and variants of it with an error in the last chunk, must
+# also lex the same in parallel chunks as with the SIMD scanner.
+# Usage: ./scanner-test.sh [mutants per test]   (default: 20)
+
+EXECUTABLE="./hw3"
+MUTANTS=${1:-20}
+INPUT_DIR="tests"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -f "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+# Writes mutant $2 of file $1: a few bytes changed at positions picked from
+# the mutant number, drawing replacements from characters the scanner treats
+# specially.
+mutate() {
+    awk -v seed="$2" 'BEGIN { RS = "^$"; srand(seed) }
+    {
+        text = $0
+        n = 1 + int(rand() * 3)
+        special = "\"\\/\n\r\t =!<>b0123456789aZ_@{}"
+        for (k = 0; k < n && length(text) > 0; k++) {
+            pos = 1 + int(rand() * length(text))
+            op = int(rand() * 3)
+            c = substr(special, 1 + int(rand() * length(special)), 1)
+            if (op == 0) text = substr(text, 1, pos - 1) substr(text, pos + 1)
+            else if (op == 1) text = substr(text, 1, pos) substr(text, pos)
+            else text = substr(text, 1, pos - 1) c substr(text, pos + 1)
+        }
+        printf "%s", text
+    }' "$1"
+}
+
+# Runs hw3 with the given arguments on $INPUT and checks its tokens and
+# output against those of the $REFERENCE scanner; prints what differs and
+# returns 1 on mismatch.
+check() {
+    "$@" --tokens < "$INPUT" > "$WORK_DIR/other.tokens"
+    "$@" < "$INPUT" > "$WORK_DIR/other.res"
+    if ! cmp -s "$WORK_DIR/expected.tokens" "$WORK_DIR/other.tokens" ||
+       ! cmp -s "$WORK_DIR/expected.res" "$WORK_DIR/other.res"; then
+        echo -e "\033[1;31mdiff $REFERENCE: $*\033[0m"
+        diff "$WORK_DIR/expected.tokens" "$WORK_DIR/other.tokens" | head -n 5
+        diff "$WORK_DIR/expected.res" "$WORK_DIR/other.res" | head -n 5
+        return 1
+    fi
+}
+
+# Writes the AST image of $INPUT and checks the analysis of the loaded image
+# against flex's output; a program that does not parse has no image, and must
+# fail with flex's message.
+check_image() {
+    if "$EXECUTABLE" --emit-ast < "$INPUT" > "$WORK_DIR/image.ast" 2> "$WORK_DIR/image.err"; then
+        "$EXECUTABLE" --ast < "$WORK_DIR/image.ast" > "$WORK_DIR/other.res"
+    else
+        cp "$WORK_DIR/image.err" "$WORK_DIR/other.res"
+    fi
+    if ! cmp -s "$WORK_DIR/expected.res" "$WORK_DIR/other.res"; then
+        echo -e "\033[1;31mdiff flex: AST image\033[0m"
+        diff "$WORK_DIR/expected.res" "$WORK_DIR/other.res" | head -n 5
+        return 1
+    fi
+}
+
+# Compares every backend with flex on $1.
+compare() {
+    local kernel
+    INPUT=$1
+    REFERENCE=flex
+    "$EXECUTABLE" --tokens --scanner=flex < "$INPUT" > "$WORK_DIR/expected.tokens"
+    "$EXECUTABLE" --scanner=flex < "$INPUT" > "$WORK_DIR/expected.res"
+    check "$EXECUTABLE" --scanner=flex --pipeline || return 1
+    check "$EXECUTABLE" --lazy || return 1
+    check "$EXECUTABLE" --stream || return 1
+    check "$EXECUTABLE" --cache="$WORK_DIR/cache" || return 1
+    check "$EXECUTABLE" --trace="$WORK_DIR/trace.json" --trace-scopes=0 || return 1
+    check_image || return 1
+    for kernel in scalar sse2 avx2; do
+        check env HW3_SIMD=$kernel "$EXECUTABLE" --scanner=simd || return 1
+        check env HW3_SIMD=$kernel "$EXECUTABLE" --scanner=simd --pipeline || return 1
+        check env HW3_SIMD=$kernel "$EXECUTABLE" --scanner=prelex || return 1
+    done
+    return 0
+}
+
+status=0
+for input_file in "$INPUT_DIR"/*.in; do
+    test_name=$(basename "$input_file" .in)
+    failed=0
+    compare "$input_file" || failed=1
+    for seed in $(seq 1 "$MUTANTS"); do
+        mutate "$input_file" "$seed" > "$WORK_DIR/mutant.in"
+        if ! compare "$WORK_DIR/mutant.in"; then
+            echo "mutant $seed of $input_file:"
+            cat "$WORK_DIR/mutant.in"
+            failed=1
+            break
+        fi
+    done
+    if [ $failed -eq 0 ]; then
+        echo -e "    \033[1;32mPASS\033[0m - $test_name"
+    else
+        echo -e "    \033[1;31mFAIL\033[0m - $test_name"
+        status=1
+    fi
+done
+
+# Inputs of a MiB or more are pre-lexed in chunks cut at newlines, one per
+# thread, whose tokens are merged with their lines shifted and which are
+# dropped after the first one that fails. A generated program of over 4 MiB
+# is lexed in four chunks with -j 4, and must give the SIMD scanner's tokens
+# and output as it is, and with a lexical error or a syntax error seven
+# eighths of the way in, that is in the last chunk.
+bench/gen-large.sh 1600 > "$WORK_DIR/chunks.in"
+lines=$(wc -l < "$WORK_DIR/chunks.in")
+awk -v at=$((lines * 7 / 8)) 'NR == at { print "    acc = acc # 1;" } { print }' "$WORK_DIR/chunks.in" \
+    > "$WORK_DIR/chunks-lexical.in"
+awk -v at=$((lines * 7 / 8)) 'NR == at { print "    acc = acc + ;" } { print }' "$WORK_DIR/chunks.in" \
+    > "$WORK_DIR/chunks-syntax.in"
+for input_file in "$WORK_DIR"/chunks*.in; do
+    test_name=$(basename "$input_file" .in)
+    INPUT=$input_file
+    REFERENCE=simd
+    "$EXECUTABLE" --tokens --scanner=simd < "$INPUT" > "$WORK_DIR/expected.tokens"
+    "$EXECUTABLE" --scanner=simd < "$INPUT" > "$WORK_DIR/expected.res"
+    if check "$EXECUTABLE" --scanner=prelex -j 4; then
+        echo -e "    \033[1;32mPASS\033[0m - $test_name (prelexed in chunks)"
+    else
+        echo -e "    \033[1;31mFAIL\033[0m - $test_name (prelexed in chunks)"
+        status=1
+    fi
+done
+
+# An entry of the analysis cache must not be used once a function is declared
+# with the name of one of its parameters, which is then an error, nor once it
+# is cut short.
+cache_case() {
+    local name=$1
+    INPUT=$WORK_DIR/$name.in
+    REFERENCE=flex
+    "$EXECUTABLE" --tokens < "$INPUT" > "$WORK_DIR/expected.tokens"
+    "$EXECUTABLE" < "$INPUT" > "$WORK_DIR/expected.res"
+    if check "$EXECUTABLE" --cache="$WORK_DIR/stale-cache"; then
+        echo -e "    \033[1;32mPASS\033[0m - $name (cached)"
+    else
+        echo -e "    \033[1;31mFAIL\033[0m - $name (cached)"
+        status=1
+    fi
+}
+echo 'void f(int g) { printi(1); } void main() { f(1); }' > "$WORK_DIR/cache-fill.in"
+echo 'void f(int g) { printi(1); } void main() { f(1); } void g() { return; }' > "$WORK_DIR/cache-collision.in"
+"$EXECUTABLE" --cache="$WORK_DIR/stale-cache" < "$WORK_DIR/cache-fill.in" > /dev/null
+cache_case cache-collision
+for entry in "$WORK_DIR"/stale-cache/*; do
+    truncate -s -1 "$entry"
+done
+cp "$WORK_DIR/cache-fill.in" "$WORK_DIR/cache-truncated.in"
+cache_case cache-truncated
+exit $status
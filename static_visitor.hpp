@@ -0,0 +1,78 @@
+#ifndef STATIC_VISITOR_HPP
+#define STATIC_VISITOR_HPP
+
+#include <cstdlib>
+#include "nodes.hpp"
+
+/* Statically dispatched visitor
+ * Derived provides an overload R visit(ast::X &node) for every node class it can be handed. dispatch() switches on
+ * the node's kind tag and calls that overload directly, so a traversal step costs one predictable switch instead of
+ * two virtual calls, and each visit can return a value (for example the type of an expression).
+ */
+template<typename Derived, typename R = void>
+class StaticVisitor {
+public:
+    R dispatch(ast::Node &node) {
+        switch (node.kind) {
+            case ast::NodeKind::Num:
+                return self().visit(static_cast<ast::Num &>(node));
+            case ast::NodeKind::NumB:
+                return self().visit(static_cast<ast::NumB &>(node));
+            case ast::NodeKind::String:
+                return self().visit(static_cast<ast::String &>(node));
+            case ast::NodeKind::Bool:
+                return self().visit(static_cast<ast::Bool &>(node));
+            case ast::NodeKind::ID:
+                return self().visit(static_cast<ast::ID &>(node));
+            case ast::NodeKind::BinOp:
+                return self().visit(static_cast<ast::BinOp &>(node));
+            case ast::NodeKind::RelOp:
+                return self().visit(static_cast<ast::RelOp &>(node));
+            case ast::NodeKind::Not:
+                return self().visit(static_cast<ast::Not &>(node));
+            case ast::NodeKind::And:
+                return self().visit(static_cast<ast::And &>(node));
+            case ast::NodeKind::Or:
+                return self().visit(static_cast<ast::Or &>(node));
+            case ast::NodeKind::Type:
+                return self().visit(static_cast<ast::Type &>(node));
+            case ast::NodeKind::Cast:
+                return self().visit(static_cast<ast::Cast &>(node));
+            case ast::NodeKind::ExpList:
+                return self().visit(static_cast<ast::ExpList &>(node));
+            case ast::NodeKind::Call:
+                return self().visit(static_cast<ast::Call &>(node));
+            case ast::NodeKind::Statements:
+                return self().visit(static_cast<ast::Statements &>(node));
+            case ast::NodeKind::Break:
+                return self().visit(static_cast<ast::Break &>(node));
+            case ast::NodeKind::Continue:
+                return self().visit(static_cast<ast::Continue &>(node));
+            case ast::NodeKind::Return:
+                return self().visit(static_cast<ast::Return &>(node));
+            case ast::NodeKind::If:
+                return self().visit(static_cast<ast::If &>(node));
+            case ast::NodeKind::While:
+                return self().visit(static_cast<ast::While &>(node));
+            case ast::NodeKind::VarDecl:
+                return self().visit(static_cast<ast::VarDecl &>(node));
+            case ast::NodeKind::Assign:
+                return self().visit(static_cast<ast::Assign &>(node));
+            case ast::NodeKind::Formal:
+                return self().visit(static_cast<ast::Formal &>(node));
+            case ast::NodeKind::Formals:
+                return self().visit(static_cast<ast::Formals &>(node));
+            case ast::NodeKind::FuncDecl:
+                return self().visit(static_cast<ast::FuncDecl &>(node));
+            case ast::NodeKind::Funcs:
+                return self().visit(static_cast<ast::Funcs &>(node));
+        }
+        // Corrupted kind tag
+        std::abort();
+    }
+
+private:
+    Derived &self() { return static_cast<Derived &>(*this); }
+};
+
+#endif //STATIC_VISITOR_HPP
@@ -3,31 +3,88 @@
 # Directories
 program="./hw3"
 input_dir="tests"
+work_dir=$(mktemp -d)
+trap 'rm -rf "$work_dir"' EXIT
+
+# Check every test in one process as well; its outputs go to a directory of
+# their own and must match those of the single-file tool byte for byte
+mkdir "$work_dir/batch"
+"$program" --batch -o "$work_dir/batch" "$input_dir"/*.in
+
+# Prints a failure: $1 names the test, $2 the expected output, $3 what was
+# printed instead, $4 the input
+fail() {
+    echo
+    echo -e "    \033[1;31mFAIL\033[0m - $1"
+    echo -e "\033[1;31mdiff $2 $3\033[0m"
+    diff --color "$2" "$3"
+    echo ---
+    echo -e "\033[1;4m$4\033[0m:"
+    cat "$4"
+    echo
+    echo ---
+    echo
+}
 
 for input_file in "$input_dir"/*.in; do
     test_name=$(basename "$input_file" .in)
-    
+
     expected_file="$input_dir/$test_name.out"
     output_file="$input_dir/$test_name.res"
-    
-    "$program" < "$input_file" > "$output_file"
-    
+    batch_file="$work_dir/batch/$test_name.res"
+
     if [[ -f "$expected_file" ]]; then
-        if diff -q "$expected_file" "$output_file" > /dev/null; then
-            echo -e "    \033[1;32mPASS\033[0m - $test_name"
+        "$program" < "$input_file" > "$output_file"
+        if ! diff -q "$expected_file" "$output_file" > /dev/null; then
+            fail "$test_name" "$expected_file" "$output_file" "$input_file"
+        elif ! diff -q "$output_file" "$batch_file" > /dev/null; then
+            fail "$test_name (--batch)" "$output_file" "$batch_file" "$input_file"
         else
-            echo
-            echo -e "    \033[1;31mFAIL\033[0m - $test_name"
-            echo -e "\033[1;31mdiff $expected_file $output_file\033[0m"
-            diff --color "$expected_file" "$output_file"
-            echo ---
-            echo -e "\033[1;4m$input_file\033[0m:"
-            cat "$input_file"
-            echo
-            echo ---
-            echo
+            echo -e "    \033[1;32mPASS\033[0m - $test_name"
         fi
     else
         echo -e "${RED}Expected file not found for test: $test_name${NC}"
     fi
 done
+
+# Pass 2 analyzes the functions on several threads when there are at least
+# 64 per thread: many_funcs (201 functions) on 3 with -j 4, and a generated
+# program of 600 on 8, with errors in two late functions of which the earlier
+# one must be reported, as the serial analysis (-j 1) reports it
+parallel() {
+    if diff -q "$2" "$3" > /dev/null; then
+        echo -e "    \033[1;32mPASS\033[0m - $1"
+    else
+        echo -e "    \033[1;31mFAIL\033[0m - $1"
+        diff --color "$2" "$3"
+    fi
+}
+for test_name in many_funcs many_funcs_error; do
+    "$program" -j 4 < "$input_dir/$test_name.in" > "$work_dir/$test_name.res"
+    parallel "$test_name (-j 4)" "$input_dir/$test_name.out" "$work_dir/$test_name.res"
+done
+bench/gen-large.sh 600 4 | sed -e '/^int f550(/a\    missing = 1;' -e '/^int f580(/a\    a = true;' \
+    > "$work_dir/late_error.in"
+"$program" -j 1 < "$work_dir/late_error.in" > "$work_dir/late_error.out"
+"$program" -j 8 < "$work_dir/late_error.in" > "$work_dir/late_error.res"
+if grep -q "missing is not defined" "$work_dir/late_error.out"; then
+    parallel "late_error (-j 8)" "$work_dir/late_error.out" "$work_dir/late_error.res"
+else
+    echo -e "    \033[1;31mFAIL\033[0m - late_error (-j 1): no error reported"
+fi
+
+# A file that fails outside analysis (here a literal too large for an int)
+# fails alone: the batch goes on and still checks the file next to it
+batch_dir="$work_dir/literal"
+mkdir "$batch_dir"
+printf 'void main() {\n    int x = 99999999999;\n}\n' > "$batch_dir/big.in"
+cp "$input_dir/t1.in" "$batch_dir/ok.in"
+"$program" --batch "$batch_dir/big.in" "$batch_dir/ok.in" 2> "$batch_dir/err"
+status=$?
+if [[ $status -eq 1 ]] && grep -q "literal out of range" "$batch_dir/err" &&
+    diff -q "$input_dir/t1.out" "$batch_dir/ok.res" > /dev/null; then
+    echo -e "    \033[1;32mPASS\033[0m - batch with an out-of-range literal"
+else
+    echo -e "    \033[1;31mFAIL\033[0m - batch with an out-of-range literal (exit $status)"
+    cat "$batch_dir/err"
+fi
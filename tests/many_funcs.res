@@ -0,0 +1,5186 @@
+---begin global scope---
+print (string) -> void
+printi (int) -> void
+f0 (int,byte) -> int
+f1 (int,byte) -> int
+f2 (int,byte) -> int
+f3 (int,byte) -> int
+f4 (int,byte) -> int
+f5 (int,byte) -> int
+f6 (int,byte) -> int
+f7 (int,byte) -> int
+f8 (int,byte) -> int
+f9 (int,byte) -> int
+f10 (int,byte) -> int
+f11 (int,byte) -> int
+f12 (int,byte) -> int
+f13 (int,byte) -> int
+f14 (int,byte) -> int
+f15 (int,byte) -> int
+f16 (int,byte) -> int
+f17 (int,byte) -> int
+f18 (int,byte) -> int
+f19 (int,byte) -> int
+f20 (int,byte) -> int
+f21 (int,byte) -> int
+f22 (int,byte) -> int
+f23 (int,byte) -> int
+f24 (int,byte) -> int
+f25 (int,byte) -> int
+f26 (int,byte) -> int
+f27 (int,byte) -> int
+f28 (int,byte) -> int
+f29 (int,byte) -> int
+f30 (int,byte) -> int
+f31 (int,byte) -> int
+f32 (int,byte) -> int
+f33 (int,byte) -> int
+f34 (int,byte) -> int
+f35 (int,byte) -> int
+f36 (int,byte) -> int
+f37 (int,byte) -> int
+f38 (int,byte) -> int
+f39 (int,byte) -> int
+f40 (int,byte) -> int
+f41 (int,byte) -> int
+f42 (int,byte) -> int
+f43 (int,byte) -> int
+f44 (int,byte) -> int
+f45 (int,byte) -> int
+f46 (int,byte) -> int
+f47 (int,byte) -> int
+f48 (int,byte) -> int
+f49 (int,byte) -> int
+f50 (int,byte) -> int
+f51 (int,byte) -> int
+f52 (int,byte) -> int
+f53 (int,byte) -> int
+f54 (int,byte) -> int
+f55 (int,byte) -> int
+f56 (int,byte) -> int
+f57 (int,byte) -> int
+f58 (int,byte) -> int
+f59 (int,byte) -> int
+f60 (int,byte) -> int
+f61 (int,byte) -> int
+f62 (int,byte) -> int
+f63 (int,byte) -> int
+f64 (int,byte) -> int
+f65 (int,byte) -> int
+f66 (int,byte) -> int
+f67 (int,byte) -> int
+f68 (int,byte) -> int
+f69 (int,byte) -> int
+f70 (int,byte) -> int
+f71 (int,byte) -> int
+f72 (int,byte) -> int
+f73 (int,byte) -> int
+f74 (int,byte) -> int
+f75 (int,byte) -> int
+f76 (int,byte) -> int
+f77 (int,byte) -> int
+f78 (int,byte) -> int
+f79 (int,byte) -> int
+f80 (int,byte) -> int
+f81 (int,byte) -> int
+f82 (int,byte) -> int
+f83 (int,byte) -> int
+f84 (int,byte) -> int
+f85 (int,byte) -> int
+f86 (int,byte) -> int
+f87 (int,byte) -> int
+f88 (int,byte) -> int
+f89 (int,byte) -> int
+f90 (int,byte) -> int
+f91 (int,byte) -> int
+f92 (int,byte) -> int
+f93 (int,byte) -> int
+f94 (int,byte) -> int
+f95 (int,byte) -> int
+f96 (int,byte) -> int
+f97 (int,byte) -> int
+f98 (int,byte) -> int
+f99 (int,byte) -> int
+f100 (int,byte) -> int
+f101 (int,byte) -> int
+f102 (int,byte) -> int
+f103 (int,byte) -> int
+f104 (int,byte) -> int
+f105 (int,byte) -> int
+f106 (int,byte) -> int
+f107 (int,byte) -> int
+f108 (int,byte) -> int
+f109 (int,byte) -> int
+f110 (int,byte) -> int
+f111 (int,byte) -> int
+f112 (int,byte) -> int
+f113 (int,byte) -> int
+f114 (int,byte) -> int
+f115 (int,byte) -> int
+f116 (int,byte) -> int
+f117 (int,byte) -> int
+f118 (int,byte) -> int
+f119 (int,byte) -> int
+f120 (int,byte) -> int
+f121 (int,byte) -> int
+f122 (int,byte) -> int
+f123 (int,byte) -> int
+f124 (int,byte) -> int
+f125 (int,byte) -> int
+f126 (int,byte) -> int
+f127 (int,byte) -> int
+f128 (int,byte) -> int
+f129 (int,byte) -> int
+f130 (int,byte) -> int
+f131 (int,byte) -> int
+f132 (int,byte) -> int
+f133 (int,byte) -> int
+f134 (int,byte) -> int
+f135 (int,byte) -> int
+f136 (int,byte) -> int
+f137 (int,byte) -> int
+f138 (int,byte) -> int
+f139 (int,byte) -> int
+f140 (int,byte) -> int
+f141 (int,byte) -> int
+f142 (int,byte) -> int
+f143 (int,byte) -> int
+f144 (int,byte) -> int
+f145 (int,byte) -> int
+f146 (int,byte) -> int
+f147 (int,byte) -> int
+f148 (int,byte) -> int
+f149 (int,byte) -> int
+f150 (int,byte) -> int
+f151 (int,byte) -> int
+f152 (int,byte) -> int
+f153 (int,byte) -> int
+f154 (int,byte) -> int
+f155 (int,byte) -> int
+f156 (int,byte) -> int
+f157 (int,byte) -> int
+f158 (int,byte) -> int
+f159 (int,byte) -> int
+f160 (int,byte) -> int
+f161 (int,byte) -> int
+f162 (int,byte) -> int
+f163 (int,byte) -> int
+f164 (int,byte) -> int
+f165 (int,byte) -> int
+f166 (int,byte) -> int
+f167 (int,byte) -> int
+f168 (int,byte) -> int
+f169 (int,byte) -> int
+f170 (int,byte) -> int
+f171 (int,byte) -> int
+f172 (int,byte) -> int
+f173 (int,byte) -> int
+f174 (int,byte) -> int
+f175 (int,byte) -> int
+f176 (int,byte) -> int
+f177 (int,byte) -> int
+f178 (int,byte) -> int
+f179 (int,byte) -> int
+f180 (int,byte) -> int
+f181 (int,byte) -> int
+f182 (int,byte) -> int
+f183 (int,byte) -> int
+f184 (int,byte) -> int
+f185 (int,byte) -> int
+f186 (int,byte) -> int
+f187 (int,byte) -> int
+f188 (int,byte) -> int
+f189 (int,byte) -> int
+f190 (int,byte) -> int
+f191 (int,byte) -> int
+f192 (int,byte) -> int
+f193 (int,byte) -> int
+f194 (int,byte) -> int
+f195 (int,byte) -> int
+f196 (int,byte) -> int
+f197 (int,byte) -> int
+f198 (int,byte) -> int
+f199 (int,byte) -> int
+main () -> void
+  ---begin scope---
+  a int -1
+  b byte -2
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  a int -1
+  b byte -2
+  acc int 0
+  k byte 1
+  flag bool 2
+    ---begin scope---
+      ---begin scope---
+      t1 int 3
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+      ---begin scope---
+        ---begin scope---
+        ---end scope---
+      ---end scope---
+    ---end scope---
+    ---begin scope---
+    local5 byte 3
+    ---end scope---
+  ---end scope---
+  ---begin scope---
+  ---end scope---
+---end global scope---
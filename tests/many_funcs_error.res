@@ -0,0 +1 @@
+line 3558: variable missing is not defined
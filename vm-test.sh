@@ -0,0 +1,204 @@
+#!/bin/bash
+
+# Runs every tests/run/*.in with --run and checks what the program prints
+# against tests/run/*.out, counting executed instructions as --stats does
+# and again without, with constants left unfolded (--no-fold), on the
+# single-file tool and in batch mode. Programs of tests/*.in that analysis
+# rejects must print the same error with --run, and every program there
+# that it accepts must lower and list with --bytecode.
+# Where the GNU assembler and linker are installed, the same programs are
+# also built with --emit-asm and --emit-asm=stack: the executables must print
+# what tests/run/*.out expects, and every accepted program must assemble.
+# Likewise where clang, or LLVM's opt and llc, are installed, with
+# --emit-llvm compiled at -O0 and -O2, and where a C compiler is, with
+# --emit-c compiled as C99 at -O0 and -O2; the C builds of the programs of
+# bench/vm must also print what the bytecode VM prints for them.
+# Usage: ./vm-test.sh
+
+EXECUTABLE="./hw3"
+RUN_DIR="tests/run"
+INPUT_DIR="tests"
+WORK_DIR=$(mktemp -d)
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+if [ ! -f "$EXECUTABLE" ]; then
+    echo "Error: $EXECUTABLE not found!"
+    echo "Please run 'make' first to build the project."
+    exit 1
+fi
+
+NATIVE=0
+if command -v as > /dev/null && command -v ld > /dev/null; then
+    NATIVE=1
+fi
+
+LLVM=0
+OPAQUE=
+if command -v clang > /dev/null; then
+    LLVM=1
+elif command -v opt > /dev/null && command -v llc > /dev/null && command -v cc > /dev/null; then
+    LLVM=1
+    # LLVM before 15 reads the opaque pointers of the module only when asked to
+    if llc --version | grep -q 'LLVM version 1[0-4]\.'; then
+        OPAQUE=-opaque-pointers
+    fi
+fi
+
+CC=${CC:-cc}
+C=0
+if command -v "$CC" > /dev/null; then
+    C=1
+fi
+
+# Assembles and links program $1 with --emit-asm$2 as $WORK_DIR/native.
+build() {
+    "$EXECUTABLE" --emit-asm$2 < "$1" > "$WORK_DIR/native.s" &&
+        as "$WORK_DIR/native.s" -o "$WORK_DIR/native.o" &&
+        ld "$WORK_DIR/native.o" -o "$WORK_DIR/native"
+}
+
+# Compiles program $1 with --emit-llvm at optimization level $2 as
+# $WORK_DIR/native.
+build_llvm() {
+    "$EXECUTABLE" --emit-llvm < "$1" > "$WORK_DIR/native.ll" || return 1
+    if command -v clang > /dev/null; then
+        clang -O$2 -Wno-override-module "$WORK_DIR/native.ll" -o "$WORK_DIR/native"
+    else
+        opt $OPAQUE -O$2 "$WORK_DIR/native.ll" -o "$WORK_DIR/native.bc" &&
+            llc $OPAQUE -O$2 -relocation-model=pic -filetype=obj "$WORK_DIR/native.bc" -o "$WORK_DIR/native.o" &&
+            cc "$WORK_DIR/native.o" -o "$WORK_DIR/native"
+    fi
+}
+
+# Compiles program $1 with --emit-c at optimization level $2 as
+# $WORK_DIR/native.
+build_c() {
+    "$EXECUTABLE" --emit-c < "$1" > "$WORK_DIR/native.c" &&
+        "$CC" -std=c99 -pedantic-errors -O$2 "$WORK_DIR/native.c" -o "$WORK_DIR/native"
+}
+
+status=0
+report() {
+    if [ "$2" -eq 0 ]; then
+        echo -e "    \033[1;32mPASS\033[0m - $1"
+    else
+        echo -e "    \033[1;31mFAIL\033[0m - $1"
+        status=1
+    fi
+}
+
+mkdir "$WORK_DIR/batch"
+"$EXECUTABLE" --batch -o "$WORK_DIR/batch" --run "$RUN_DIR"/*.in
+for input_file in "$RUN_DIR"/*.in; do
+    test_name=$(basename "$input_file" .in)
+    expected_file="$RUN_DIR/$test_name.out"
+    failed=0
+    for args in "--run" "--run --stats=json" "--run --no-fold"; do
+        "$EXECUTABLE" $args < "$input_file" > "$WORK_DIR/run.res" 2> /dev/null
+        if ! cmp -s "$expected_file" "$WORK_DIR/run.res"; then
+            echo -e "\033[1;31mdiff $expected_file: $args\033[0m"
+            diff "$expected_file" "$WORK_DIR/run.res" | head -n 5
+            failed=1
+        fi
+    done
+    if ! cmp -s "$expected_file" "$WORK_DIR/batch/$test_name.res"; then
+        echo -e "\033[1;31mdiff $expected_file: --batch --run\033[0m"
+        diff "$expected_file" "$WORK_DIR/batch/$test_name.res" | head -n 5
+        failed=1
+    fi
+    for mode in "" "=stack"; do
+        [ $NATIVE -eq 1 ] || break
+        if ! build "$input_file" "$mode"; then
+            echo -e "\033[1;31mcannot build $input_file: --emit-asm$mode\033[0m"
+            failed=1
+            continue
+        fi
+        "$WORK_DIR/native" > "$WORK_DIR/native.res"
+        if ! cmp -s "$expected_file" "$WORK_DIR/native.res"; then
+            echo -e "\033[1;31mdiff $expected_file: --emit-asm$mode\033[0m"
+            diff "$expected_file" "$WORK_DIR/native.res" | head -n 5
+            failed=1
+        fi
+    done
+    for level in 0 2; do
+        [ $LLVM -eq 1 ] || break
+        if ! build_llvm "$input_file" $level; then
+            echo -e "\033[1;31mcannot build $input_file: --emit-llvm -O$level\033[0m"
+            failed=1
+            continue
+        fi
+        "$WORK_DIR/native" > "$WORK_DIR/native.res"
+        if ! cmp -s "$expected_file" "$WORK_DIR/native.res"; then
+            echo -e "\033[1;31mdiff $expected_file: --emit-llvm -O$level\033[0m"
+            diff "$expected_file" "$WORK_DIR/native.res" | head -n 5
+            failed=1
+        fi
+    done
+    for level in 0 2; do
+        [ $C -eq 1 ] || break
+        if ! build_c "$input_file" $level; then
+            echo -e "\033[1;31mcannot build $input_file: --emit-c -O$level\033[0m"
+            failed=1
+            continue
+        fi
+        "$WORK_DIR/native" > "$WORK_DIR/native.res"
+        if ! cmp -s "$expected_file" "$WORK_DIR/native.res"; then
+            echo -e "\033[1;31mdiff $expected_file: --emit-c -O$level\033[0m"
+            diff "$expected_file" "$WORK_DIR/native.res" | head -n 5
+            failed=1
+        fi
+    done
+    report "run/$test_name" $failed
+done
+
+# The bytecode VM is the reference for what the C builds print
+for input_file in bench/vm/*.in; do
+    [ $C -eq 1 ] || break
+    test_name=$(basename "$input_file" .in)
+    failed=0
+    "$EXECUTABLE" --run < "$input_file" > "$WORK_DIR/run.res"
+    for level in 0 2; do
+        if ! build_c "$input_file" $level; then
+            echo -e "\033[1;31mcannot build $input_file: --emit-c -O$level\033[0m"
+            failed=1
+            continue
+        fi
+        "$WORK_DIR/native" > "$WORK_DIR/native.res"
+        if ! cmp -s "$WORK_DIR/run.res" "$WORK_DIR/native.res"; then
+            echo -e "\033[1;31mdiff $input_file: --run against --emit-c -O$level\033[0m"
+            diff "$WORK_DIR/run.res" "$WORK_DIR/native.res" | head -n 5
+            failed=1
+        fi
+    done
+    report "bench/vm/$test_name" $failed
+done
+
+for input_file in "$INPUT_DIR"/*.in; do
+    test_name=$(basename "$input_file" .in)
+    failed=0
+    "$EXECUTABLE" < "$input_file" > "$WORK_DIR/check.res"
+    # A rejected program's output ends with its error instead of the global scope
+    if [ "$(tail -n 1 "$WORK_DIR/check.res")" != "---end global scope---" ]; then
+        "$EXECUTABLE" --run < "$input_file" > "$WORK_DIR/run.res"
+        if ! cmp -s "$WORK_DIR/check.res" "$WORK_DIR/run.res"; then
+            echo -e "\033[1;31mdiff error: --run\033[0m"
+            diff "$WORK_DIR/check.res" "$WORK_DIR/run.res" | head -n 5
+            failed=1
+        fi
+    elif ! "$EXECUTABLE" --bytecode < "$input_file" > "$WORK_DIR/list.res" ||
+         ! grep -q '^main ' "$WORK_DIR/list.res"; then
+        echo -e "\033[1;31mno bytecode listed for $input_file\033[0m"
+        failed=1
+    elif [ $NATIVE -eq 1 ] && ! build "$input_file" ""; then
+        echo -e "\033[1;31mcannot build $input_file: --emit-asm\033[0m"
+        failed=1
+    elif [ $LLVM -eq 1 ] && ! build_llvm "$input_file" 0; then
+        echo -e "\033[1;31mcannot build $input_file: --emit-llvm\033[0m"
+        failed=1
+    elif [ $C -eq 1 ] && ! build_c "$input_file" 0; then
+        echo -e "\033[1;31mcannot build $input_file: --emit-c\033[0m"
+        failed=1
+    fi
+    report "$test_name" $failed
+done
+exit $status